@@ -0,0 +1,276 @@
+#ifndef BENCHSUITE_H
+#define BENCHSUITE_H
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../Headers/Batch.h"
+
+using namespace std;
+
+/**
+ * @brief Timing state of one repetition of a benchmark case.
+ * The case does its setup, brackets the measured work with start()/stop(operations), then
+ * tears down; only the bracketed time counts.
+ */
+class BenchState {
+private:
+    size_t n;
+    chrono::steady_clock::time_point started;
+    double elapsed_ns = 0;
+    long long operations = 0;
+
+public:
+    explicit BenchState(size_t n) : n(n) {}
+
+    // The data size this repetition runs at
+    size_t size() const { return n; }
+
+    void start() { started = chrono::steady_clock::now(); }
+    void stop(long long ops) {
+        elapsed_ns += chrono::duration<double, nano>(chrono::steady_clock::now() - started).count();
+        operations += ops;
+    }
+
+    double elapsedNs() const { return elapsed_ns; }
+    long long operationCount() const { return operations; }
+};
+
+/**
+ * @brief The result of one case at one size: nanoseconds per operation over its repetitions.
+ */
+struct BenchResult {
+    string name;
+    size_t size = 0;
+    int repetitions = 0;
+    long long operations = 0; // per repetition
+    double median_ns = 0;
+    double min_ns = 0;
+};
+
+/**
+ * @brief A small benchmark harness: named cases, each run at several data sizes.
+ *
+ * Every (case, size) pair is repeated until it has run for at least the minimum time (and at
+ * least three times); the median time per operation is reported. Results are printed as a table
+ * and can be written as JSON lines, one object per result in the batch format, e.g.
+ *   {"benchmark":"HashTable/insert","size":1000,"repetitions":9,"operations":1000,"ns_per_op":312.4,...}
+ * A previous JSON file can be given as a baseline; results more than the threshold slower than
+ * the baseline are flagged and make run() return 1.
+ */
+class BenchSuite {
+private:
+    struct Case {
+        string name;
+        vector<size_t> sizes;
+        function<void(BenchState&)> body;
+    };
+
+    string suite_name;
+    vector<Case> cases;
+
+    static double median_of(vector<double> values) {
+        sort(values.begin(), values.end());
+        size_t mid = values.size() / 2;
+        return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2.0;
+    }
+
+    static string number(double value) {
+        char text[32];
+        snprintf(text, sizeof(text), "%.1f", value);
+        return text;
+    }
+
+    static string key_of(const string& name, size_t size) {
+        return name + "/" + to_string(size);
+    }
+
+    BenchResult measure(const Case& bench, size_t size, double min_time_ms) const;
+    string contextLine() const;
+    static string resultLine(const BenchResult& result);
+    static bool readBaseline(const string& path, map<string, double>& baseline);
+
+public:
+    explicit BenchSuite(const string& name) : suite_name(name) {}
+
+    // Registers a case run once per size
+    void add(const string& name, vector<size_t> sizes, function<void(BenchState&)> body) {
+        cases.push_back({name, move(sizes), move(body)});
+    }
+
+    /**
+     * @brief Runs the cases selected on the command line:
+     *   --filter <text>       only cases whose name contains the text
+     *   --max-size <n>        skip larger sizes (for quick runs)
+     *   --min-time <ms>       minimum measured time per case and size (default 200)
+     *   --json <path>         write the results as JSON lines ("-" for stdout)
+     *   --baseline <path>     compare with an earlier --json file
+     *   --threshold <percent> slowdown reported as a regression (default 10)
+     */
+    int run(int argc, char* argv[]) const;
+};
+
+BenchResult BenchSuite::measure(const Case& bench, size_t size, double min_time_ms) const {
+    const int min_repetitions = 3;
+    const int max_repetitions = 1000;
+    vector<double> per_op;
+    double total_ms = 0;
+    BenchResult result;
+    result.name = bench.name;
+    result.size = size;
+    while ((total_ms < min_time_ms || static_cast<int>(per_op.size()) < min_repetitions)
+           && static_cast<int>(per_op.size()) < max_repetitions) {
+        BenchState state(size);
+        bench.body(state);
+        long long ops = max(1LL, state.operationCount());
+        per_op.push_back(state.elapsedNs() / static_cast<double>(ops));
+        total_ms += state.elapsedNs() / 1e6;
+        result.operations = ops;
+    }
+    result.repetitions = static_cast<int>(per_op.size());
+    result.median_ns = median_of(per_op);
+    result.min_ns = *min_element(per_op.begin(), per_op.end());
+    return result;
+}
+
+string BenchSuite::contextLine() const {
+    char date[32];
+    time_t now = time(nullptr);
+    tm utc;
+    gmtime_r(&now, &utc);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", &utc);
+    string line = "{\"suite\":";
+    append_json_string(line, suite_name);
+    line += ",\"date\":";
+    append_json_string(line, date);
+    line += ",\"compiler\":";
+    append_json_string(line, __VERSION__);
+#ifdef __OPTIMIZE__
+    line += ",\"optimized\":true";
+#else
+    line += ",\"optimized\":false";
+#endif
+    line += ",\"hardware_threads\":" + to_string(thread::hardware_concurrency()) + "}";
+    return line;
+}
+
+string BenchSuite::resultLine(const BenchResult& result) {
+    string line = "{\"benchmark\":";
+    append_json_string(line, result.name);
+    line += ",\"size\":" + to_string(result.size);
+    line += ",\"repetitions\":" + to_string(result.repetitions);
+    line += ",\"operations\":" + to_string(result.operations);
+    line += ",\"ns_per_op\":" + number(result.median_ns);
+    line += ",\"min_ns_per_op\":" + number(result.min_ns);
+    line += ",\"ops_per_second\":" + number(result.median_ns > 0 ? 1e9 / result.median_ns : 0) + "}";
+    return line;
+}
+
+bool BenchSuite::readBaseline(const string& path, map<string, double>& baseline) {
+    ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    string line;
+    JsonObject fields;
+    while (getline(in, line)) {
+        int size;
+        if (!fields.parse(line) || !fields.has("benchmark") || !fields.getInt("size", size)) {
+            continue; // the context line, or not a result
+        }
+        baseline[key_of(fields.get("benchmark"), static_cast<size_t>(size))] = atof(fields.get("ns_per_op").c_str());
+    }
+    return true;
+}
+
+int BenchSuite::run(int argc, char* argv[]) const {
+    string filter, json_path, baseline_path;
+    size_t max_size = 0;
+    double min_time_ms = 200;
+    double threshold = 10;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--filter" && has_value) filter = argv[++i];
+        else if (arg == "--max-size" && has_value) max_size = static_cast<size_t>(atoll(argv[++i]));
+        else if (arg == "--min-time" && has_value) min_time_ms = atof(argv[++i]);
+        else if (arg == "--json" && has_value) json_path = argv[++i];
+        else if (arg == "--baseline" && has_value) baseline_path = argv[++i];
+        else if (arg == "--threshold" && has_value) threshold = atof(argv[++i]);
+        else {
+            cerr << "Usage: " << argv[0] << " [--filter text] [--max-size n] [--min-time ms] [--json path]"
+                 << " [--baseline path] [--threshold percent]\n";
+            return 2;
+        }
+    }
+
+    map<string, double> baseline;
+    if (!baseline_path.empty() && !readBaseline(baseline_path, baseline)) {
+        cerr << "Could not read baseline " << baseline_path << "\n";
+        return 2;
+    }
+    ofstream json_file;
+    ostream* json = nullptr;
+    if (json_path == "-") {
+        json = &cout;
+    } else if (!json_path.empty()) {
+        json_file.open(json_path);
+        if (!json_file) {
+            cerr << "Could not write " << json_path << "\n";
+            return 2;
+        }
+        json = &json_file;
+    }
+    // With JSON on stdout the table goes to stderr
+    ostream& table = (json == &cout) ? cerr : cout;
+    if (json) *json << contextLine() << "\n";
+
+    table << fixed << setprecision(1);
+    table << left << setw(32) << "benchmark" << right << setw(10) << "size" << setw(14) << "ns/op"
+          << setw(14) << "min ns/op" << setw(6) << "reps";
+    if (!baseline.empty()) table << setw(12) << "vs base";
+    table << "\n";
+
+    int regressions = 0;
+    for (const Case& bench : cases) {
+        if (!filter.empty() && bench.name.find(filter) == string::npos) {
+            continue;
+        }
+        for (size_t size : bench.sizes) {
+            if (max_size > 0 && size > max_size) {
+                continue;
+            }
+            BenchResult result = measure(bench, size, min_time_ms);
+            table << left << setw(32) << result.name << right << setw(10) << result.size << setw(14) << result.median_ns
+                  << setw(14) << result.min_ns << setw(6) << result.repetitions;
+            auto base = baseline.find(key_of(result.name, result.size));
+            if (base != baseline.end() && base->second > 0) {
+                double change = (result.median_ns / base->second - 1.0) * 100.0;
+                table << setw(11) << showpos << change << "%" << noshowpos;
+                if (change > threshold) {
+                    table << "  REGRESSION";
+                    regressions++;
+                }
+            }
+            table << endl;
+            if (json) *json << resultLine(result) << "\n";
+        }
+    }
+    if (!baseline.empty()) {
+        table << regressions << " result(s) more than " << threshold << "% slower than " << baseline_path << "\n";
+    }
+    return regressions == 0 ? 0 : 1;
+}
+
+#endif // BENCHSUITE_H
@@ -0,0 +1,94 @@
+#ifndef BENCHUTIL_H
+#define BENCHUTIL_H
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include "../Headers/Map.h"
+
+using namespace std;
+
+/**
+ * @brief Wall-clock stopwatch in milliseconds.
+ */
+class Timer {
+private:
+    chrono::steady_clock::time_point start;
+
+public:
+    Timer() : start(chrono::steady_clock::now()) {}
+    void restart() { start = chrono::steady_clock::now(); }
+    double elapsedMs() const {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+};
+
+/**
+ * @brief The p-th percentile (0-1) of already sorted values, 0 if there are none.
+ */
+double percentile(const vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[min(index, sorted.size() - 1)];
+}
+
+string grid_node_name(int row, int col) {
+    return "B" + to_string(row) + "_" + to_string(col);
+}
+
+/**
+ * @brief Builds a synthetic campus: a rows x cols grid of buildings joined by walkways of
+ * 1-3 minutes, plus a few diagonal shortcuts. Deterministic for a given seed.
+ */
+void build_grid_campus(NULMapGraph& graph, int rows, int cols, unsigned seed = 42) {
+    mt19937 rng(seed);
+    uniform_real_distribution<double> walk(1.0, 3.0);
+    uniform_int_distribution<int> shortcut(0, 19);
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            if (c + 1 < cols) graph.add_path(grid_node_name(r, c), grid_node_name(r, c + 1), walk(rng));
+            if (r + 1 < rows) graph.add_path(grid_node_name(r, c), grid_node_name(r + 1, c), walk(rng));
+            if (r + 1 < rows && c + 1 < cols && shortcut(rng) == 0) {
+                graph.add_path(grid_node_name(r, c), grid_node_name(r + 1, c + 1), walk(rng) * 1.5);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Builds a rows x cols grid campus with coordinates: buildings 100 m apart, walking
+ * times at 84 m/min (about 5 km/h) stretched by a random 0-60% detour factor.
+ */
+void build_geometric_grid_campus(NULMapGraph& graph, int rows, int cols, unsigned seed = 42) {
+    const double spacing = 100.0;
+    const double speed = 84.0;
+    mt19937 rng(seed);
+    uniform_real_distribution<double> detour(1.0, 1.6);
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            graph.set_coordinates(grid_node_name(r, c), c * spacing, r * spacing);
+            if (c + 1 < cols) graph.add_path(grid_node_name(r, c), grid_node_name(r, c + 1), spacing / speed * detour(rng));
+            if (r + 1 < rows) graph.add_path(grid_node_name(r, c), grid_node_name(r + 1, c), spacing / speed * detour(rng));
+        }
+    }
+}
+
+/**
+ * @brief Random (start, end) building pairs for a rows x cols grid campus.
+ */
+vector<pair<string, string>> random_grid_queries(int rows, int cols, size_t count, unsigned seed = 7) {
+    mt19937 rng(seed);
+    uniform_int_distribution<int> row(0, rows - 1);
+    uniform_int_distribution<int> col(0, cols - 1);
+    vector<pair<string, string>> queries;
+    for (size_t i = 0; i < count; ++i) {
+        queries.push_back({grid_node_name(row(rng), col(rng)), grid_node_name(row(rng), col(rng))});
+    }
+    return queries;
+}
+
+#endif // BENCHUTIL_H
@@ -0,0 +1,56 @@
+// A* vs. Dijkstra on a large generated grid with building coordinates.
+// Build: g++ -std=c++17 -O2 -pthread Benchmarks/astar_benchmark.cpp -o astar_benchmark
+// Usage: ./astar_benchmark [side=500] [queries=500]
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "BenchUtil.h"
+#include "../Headers/Map.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    int side = argc > 1 ? atoi(argv[1]) : 500;
+    size_t query_count = argc > 2 ? static_cast<size_t>(atoi(argv[2])) : 500;
+
+    NULMapGraph graph;
+    build_geometric_grid_campus(graph, side, side);
+    graph.freeze();
+    const CSRGraph& csr = graph.compiled_graph();
+    cout << "Grid campus: " << csr.nodeCount() << " nodes, " << csr.arcCount() << " arcs, heuristic "
+         << (csr.hasCoordinates() ? "on" : "off") << "\n";
+
+    vector<pair<string, string>> queries = random_grid_queries(side, side, query_count);
+    SearchScratch scratch;
+    size_t dijkstra_settled = 0, astar_settled = 0, mismatches = 0;
+    vector<double> dijkstra_distance;
+
+    Timer timer;
+    for (const auto& q : queries) {
+        uint32_t s = csr.idOf(q.first), t = csr.idOf(q.second);
+        dijkstra_settled += csr.search(s, t, scratch);
+        dijkstra_distance.push_back(scratch.distance(t));
+    }
+    double dijkstra_ms = timer.elapsedMs();
+
+    timer.restart();
+    for (size_t i = 0; i < queries.size(); ++i) {
+        uint32_t s = csr.idOf(queries[i].first), t = csr.idOf(queries[i].second);
+        astar_settled += csr.astarSearch(s, t, scratch);
+        if (fabs(scratch.distance(t) - dijkstra_distance[i]) > 1e-9) mismatches++;
+    }
+    double astar_ms = timer.elapsedMs();
+
+    double n = static_cast<double>(queries.size());
+    cout << fixed << setprecision(1);
+    cout << "Dijkstra: " << dijkstra_settled / n << " settled/query, " << setprecision(3) << dijkstra_ms / n << " ms/query\n";
+    cout << setprecision(1);
+    cout << "A*:       " << astar_settled / n << " settled/query, " << setprecision(3) << astar_ms / n << " ms/query\n";
+    cout << setprecision(2);
+    cout << "Settled ratio: " << static_cast<double>(astar_settled) / dijkstra_settled
+         << ", speedup: " << dijkstra_ms / astar_ms << "x\n";
+    cout << "Mismatched distances: " << mismatches << "\n";
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,78 @@
+// Route cache: repeated queries answered from the LRU cache vs. searching every time.
+// Build: g++ -std=c++17 -O2 -pthread Benchmarks/cache_benchmark.cpp -o cache_benchmark
+// Usage: ./cache_benchmark [nodes=100000] [distinct_pairs=200] [queries=20000]
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "BenchUtil.h"
+#include "../Headers/Map.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    int nodes = argc > 1 ? atoi(argv[1]) : 100000;
+    size_t pair_count = argc > 2 ? static_cast<size_t>(atoi(argv[2])) : 200;
+    size_t query_count = argc > 3 ? static_cast<size_t>(atoi(argv[3])) : 20000;
+    int side = max(2, static_cast<int>(sqrt(static_cast<double>(nodes))));
+
+    NULMapGraph graph;
+    build_grid_campus(graph, side, side);
+    graph.freeze();
+    cout << "Synthetic campus: " << graph.compiled_graph().nodeCount() << " nodes, "
+         << pair_count << " popular pairs, " << query_count << " queries\n";
+
+    // Popular pairs are asked for much more often than the rest (roughly Zipf-shaped)
+    vector<pair<string, string>> pairs = random_grid_queries(side, side, pair_count);
+    vector<size_t> stream;
+    mt19937 rng(3);
+    uniform_real_distribution<double> u(0.0, 1.0);
+    for (size_t i = 0; i < query_count; ++i) {
+        stream.push_back(min(pair_count - 1, static_cast<size_t>(pow(static_cast<double>(pair_count), u(rng))) - 1));
+    }
+
+    // 1. No cache: a sample of the stream, searched every time
+    graph.set_route_cache_capacity(0);
+    size_t sample = min<size_t>(stream.size(), 500);
+    vector<double> reference(pair_count, -1.0);
+    Timer timer;
+    for (size_t i = 0; i < sample; ++i) {
+        const auto& q = pairs[stream[i]];
+        reference[stream[i]] = graph.shortest_route(q.first, q.second).distance;
+    }
+    double uncached_ms = timer.elapsedMs() / sample;
+
+    // 2. Cached: whole stream
+    graph.set_route_cache_capacity(DEFAULT_ROUTE_CACHE_CAPACITY);
+    uint64_t misses_before = graph.route_cache_stats().misses();
+    size_t mismatches = 0;
+    timer.restart();
+    for (size_t index : stream) {
+        Route route = graph.shortest_route(pairs[index].first, pairs[index].second);
+        if (reference[index] >= 0.0 && fabs(route.distance - reference[index]) > 1e-9) mismatches++;
+    }
+    double cached_ms = timer.elapsedMs() / stream.size();
+    uint64_t stream_hits = graph.route_cache_stats().hits();
+    uint64_t stream_misses = graph.route_cache_stats().misses() - misses_before;
+
+    // 3. A closed walkway on a cached route must not be served stale
+    const auto& probe = pairs[stream[0]];
+    Route before = graph.shortest_route(probe.first, probe.second);
+    if (before.path.size() >= 2) {
+        graph.remove_path(before.path[0], before.path[1]);
+        Route after = graph.shortest_route(probe.first, probe.second);
+        SearchScratch scratch;
+        const CSRGraph& csr = graph.compiled_graph();
+        NodeRoute fresh = csr.shortestPath(csr.idOf(probe.first), csr.idOf(probe.second), scratch);
+        if (fabs(after.distance - fresh.distance) > 1e-9) mismatches++;
+    }
+
+    cout << setprecision(4) << fixed;
+    cout << "Search every time: " << uncached_ms << " ms/query\n";
+    cout << "With route cache:  " << cached_ms << " ms/query (" << stream_hits << " hits, "
+         << stream_misses << " misses)\n";
+    cout << "Speedup:           " << setprecision(1) << uncached_ms / cached_ms << "x\n";
+    cout << "Mismatched distances: " << mismatches << "\n";
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+// Contraction hierarchy benchmark: preprocessing, cache round trip and query latency against
+// Dijkstra on the compiled graph.
+// Build: g++ -std=c++17 -O2 -pthread Benchmarks/ch_benchmark.cpp -o ch_benchmark
+// Usage: ./ch_benchmark [nodes=100000] [queries=1000]
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstdio>
+
+#include "BenchUtil.h"
+#include "../Headers/Map.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    int nodes = argc > 1 ? atoi(argv[1]) : 100000;
+    size_t query_count = argc > 2 ? static_cast<size_t>(atoi(argv[2])) : 1000;
+    int side = max(2, static_cast<int>(sqrt(static_cast<double>(nodes))));
+    const string cache_file = "ch_benchmark.bin";
+
+    NULMapGraph graph;
+    build_grid_campus(graph, side, side);
+    graph.freeze();
+    const CSRGraph& csr = graph.compiled_graph();
+    cout << "Synthetic campus: " << csr.nodeCount() << " nodes, " << csr.arcCount() << " arcs\n";
+
+    // 1. Preprocessing
+    Timer timer;
+    ContractionHierarchy hierarchy;
+    hierarchy.build(csr);
+    double build_ms = timer.elapsedMs();
+    cout << fixed << setprecision(1);
+    cout << "Contraction:   " << build_ms << " ms, " << hierarchy.shortcutCount() << " shortcuts, "
+         << hierarchy.memoryBytes() / 1024 << " KiB\n";
+
+    // 2. Cache round trip
+    timer.restart();
+    bool saved = hierarchy.save(cache_file);
+    double save_ms = timer.elapsedMs();
+    timer.restart();
+    ContractionHierarchy loaded;
+    bool load_ok = saved && loaded.load(cache_file, csr);
+    double load_ms = timer.elapsedMs();
+    remove(cache_file.c_str());
+    cout << "Cache:         save " << save_ms << " ms, load " << load_ms << " ms"
+         << (load_ok ? "" : " (FAILED)") << "\n";
+
+    // 3. Queries
+    vector<pair<string, string>> queries = random_grid_queries(side, side, query_count);
+    vector<pair<uint32_t, uint32_t>> ids;
+    for (const auto& q : queries) {
+        ids.push_back({csr.idOf(q.first), csr.idOf(q.second)});
+    }
+
+    SearchScratch scratch;
+    vector<double> reference;
+    timer.restart();
+    for (const auto& q : ids) {
+        csr.search(q.first, q.second, scratch);
+        reference.push_back(scratch.distance(q.second));
+    }
+    double dijkstra_ms = timer.elapsedMs();
+
+    HierarchyScratch hierarchy_scratch;
+    vector<double> latencies;
+    size_t mismatches = 0;
+    double total_ms = 0.0;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        Timer query_timer;
+        uint32_t meet;
+        double distance = loaded.search(ids[i].first, ids[i].second, hierarchy_scratch, meet);
+        double ms = query_timer.elapsedMs();
+        latencies.push_back(ms);
+        total_ms += ms;
+        if (fabs(distance - reference[i]) > 1e-6 * max(1.0, reference[i])) mismatches++;
+    }
+    sort(latencies.begin(), latencies.end());
+
+    // Full routes (search + unpacking), checked against the distance they report
+    timer.restart();
+    for (size_t i = 0; i < ids.size(); ++i) {
+        NodeRoute route = loaded.route(ids[i].first, ids[i].second, hierarchy_scratch);
+        double sum = 0.0;
+        for (double w : route.segment_weights) sum += w;
+        if (route.path.empty() || route.path.front() != ids[i].first || route.path.back() != ids[i].second
+            || fabs(sum - reference[i]) > 1e-6 * max(1.0, reference[i])) {
+            mismatches++;
+        }
+    }
+    double route_ms = timer.elapsedMs();
+
+    double n = static_cast<double>(ids.size());
+    cout << setprecision(4);
+    cout << "Dijkstra:      " << dijkstra_ms / n << " ms/query\n";
+    cout << "CH distance:   " << total_ms / n << " ms/query (p50 " << latencies[latencies.size() / 2]
+         << ", p99 " << latencies[latencies.size() * 99 / 100] << ")\n";
+    cout << "CH route:      " << route_ms / n << " ms/query (with unpacking)\n";
+    cout << setprecision(1);
+    cout << "Speedup:       " << dijkstra_ms / total_ms << "x\n";
+    cout << "Mismatched distances: " << mismatches << "\n";
+    return (mismatches == 0 && load_ok) ? 0 : 1;
+}
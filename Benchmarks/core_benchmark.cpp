@@ -0,0 +1,293 @@
+// Core data structures at several data sizes: the user hash table, a lab's slot tree, a user's
+// bookings, shortest paths and the save/load round trip. Results can be written as JSON lines
+// and compared with an earlier run to catch regressions.
+// Build: g++ -std=c++17 -O2 -pthread Benchmarks/core_benchmark.cpp -o core_benchmark
+// Usage: ./core_benchmark [--filter HashTable] [--max-size n] [--min-time ms]
+//                         [--json results.jsonl] [--baseline old.jsonl] [--threshold percent]
+//
+// The storage cases write users.d/ and resources.d/ in a scratch directory under the system
+// temporary directory, removed afterwards.
+
+#include <iostream>
+#include <filesystem>
+#include <memory>
+#include <unistd.h>
+
+#include "BenchUtil.h"
+#include "BenchSuite.h"
+#include "../Headers/Hashtable.h"
+#include "../Headers/LectureHall.h"
+#include "../Headers/textfiles.h"
+
+using namespace std;
+
+// The engine's globals (main.cpp defines them in the real program)
+int next_user_id = 1;
+int next_resource_id = 1;
+map<int, Resource*> resources_table;
+
+// main.cpp's user table size, so the lookups see the program's chain lengths
+const int MAIN_TABLE_BUCKETS = 10;
+// The storage cases use a larger table so that they measure the files, not the chains
+const int STORAGE_TABLE_BUCKETS = 4096;
+
+vector<string> user_names(size_t n) {
+    vector<string> names;
+    names.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        names.push_back("user" + to_string(i));
+    }
+    return names;
+}
+
+// The same values in a fixed random order
+template <class T>
+vector<T> shuffled(vector<T> values, unsigned seed = 11) {
+    mt19937 rng(seed);
+    shuffle(values.begin(), values.end(), rng);
+    return values;
+}
+
+vector<int> slot_ids(size_t n) {
+    vector<int> ids;
+    for (size_t i = 0; i < n; ++i) {
+        ids.push_back(100 + static_cast<int>(i)); // above the default slots 1-7
+    }
+    return shuffled(ids);
+}
+
+void fill_users(HashTable& table, const vector<string>& names) {
+    for (size_t i = 0; i < names.size(); ++i) {
+        table.insert(static_cast<int>(i) + 1, names[i], "password", "Student");
+    }
+}
+
+void fill_slots(Lab& lab, const vector<int>& ids) {
+    for (int id : ids) {
+        lab.addSlot(Slot(id, "Monday", "08:00", "10:00"));
+    }
+}
+
+// Grid campuses are built once per size and shared by every repetition
+const NULMapGraph& campus_of(size_t buildings) {
+    static map<size_t, unique_ptr<NULMapGraph>> campuses;
+    unique_ptr<NULMapGraph>& campus = campuses[buildings];
+    if (!campus) {
+        int side = max(2, static_cast<int>(sqrt(static_cast<double>(buildings))));
+        campus = make_unique<NULMapGraph>();
+        build_grid_campus(*campus, side, side);
+        campus->freeze();
+    }
+    return *campus;
+}
+
+// Users with one lab booking each, against `labs` labs in resources_table
+void make_storage_data(HashTable& table, size_t users, size_t labs) {
+    for (auto& entry : resources_table) delete entry.second;
+    resources_table.clear();
+    for (size_t i = 1; i <= labs; ++i) {
+        Lab* lab = new Lab(static_cast<int>(i), "Lab " + to_string(i), "LAB", Location("Building " + to_string(i % 40)), true);
+        lab->addLabSlots();
+        resources_table[static_cast<int>(i)] = lab;
+    }
+    vector<string> names = user_names(users);
+    fill_users(table, names);
+    for (size_t i = 0; i < users; ++i) {
+        table.get(names[i])->loadBooking(resources_table.at(static_cast<int>(i % labs) + 1), static_cast<int>(i % 7) + 1);
+    }
+}
+
+/**
+ * @brief Runs a storage case inside a scratch directory (the data files use fixed relative
+ * names), returning to the working directory afterwards so output paths stay as given.
+ */
+class ScratchDirectory {
+private:
+    filesystem::path original;
+
+public:
+    static filesystem::path path() {
+        return filesystem::temp_directory_path() / ("nul_core_benchmark." + to_string(getpid()));
+    }
+    ScratchDirectory() : original(filesystem::current_path()) {
+        filesystem::create_directories(path());
+        filesystem::current_path(path());
+    }
+    ~ScratchDirectory() { filesystem::current_path(original); }
+};
+
+void clear_storage() {
+    filesystem::remove_all(USER_SEGMENT_DIR);
+    filesystem::remove_all(RESOURCE_SEGMENT_DIR);
+    user_changes().clear();
+    resource_changes().clear();
+}
+
+void check(bool ok, const char* what) {
+    if (!ok) {
+        cerr << "Benchmark check failed: " << what << "\n";
+        exit(2);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // Booking and storage events are Info; only this benchmark's report is printed
+    engine_log.setLevel(LogLevel::Warn);
+
+    BenchSuite suite("core_benchmark");
+
+    // --- User hash table ---
+    suite.add("HashTable/insert", {100, 1000, 10000}, [](BenchState& state) {
+        vector<string> names = user_names(state.size());
+        user_changes().clear();
+        HashTable table(MAIN_TABLE_BUCKETS);
+        state.start();
+        fill_users(table, names);
+        state.stop(static_cast<long long>(names.size()));
+    });
+    suite.add("HashTable/get", {100, 1000, 10000}, [](BenchState& state) {
+        vector<string> names = user_names(state.size());
+        user_changes().clear();
+        HashTable table(MAIN_TABLE_BUCKETS);
+        fill_users(table, names);
+        names = shuffled(names);
+        size_t found = 0;
+        state.start();
+        for (const string& name : names) found += table.get(name) != nullptr;
+        state.stop(static_cast<long long>(names.size()));
+        check(found == names.size(), "every user is found");
+    });
+    suite.add("HashTable/login", {100, 1000, 10000}, [](BenchState& state) {
+        vector<string> names = user_names(state.size());
+        user_changes().clear();
+        HashTable table(MAIN_TABLE_BUCKETS);
+        fill_users(table, names);
+        names = shuffled(names);
+        size_t accepted = 0;
+        state.start();
+        for (const string& name : names) accepted += table.login(name, "password") != nullptr;
+        state.stop(static_cast<long long>(names.size()));
+        check(accepted == names.size(), "every login is accepted");
+    });
+
+    // --- Lab slot tree ---
+    suite.add("Lab/addSlot", {100, 1000, 10000}, [](BenchState& state) {
+        vector<int> ids = slot_ids(state.size());
+        Lab lab(1, "Bench Lab", "LAB", Location("Building 1"), true);
+        lab.getSlots(); // builds the default slots outside the timing
+        state.start();
+        fill_slots(lab, ids);
+        state.stop(static_cast<long long>(ids.size()));
+    });
+    suite.add("Lab/findSlot", {100, 1000, 10000}, [](BenchState& state) {
+        vector<int> ids = slot_ids(state.size());
+        Lab lab(1, "Bench Lab", "LAB", Location("Building 1"), true);
+        fill_slots(lab, ids);
+        ids = shuffled(ids, 13);
+        size_t free_slots = 0;
+        state.start();
+        for (int id : ids) free_slots += lab.isSlotFree(id);
+        state.stop(static_cast<long long>(ids.size()));
+        check(free_slots == ids.size(), "every slot is found free");
+    });
+    suite.add("Lab/getSlots", {100, 1000, 10000}, [](BenchState& state) {
+        vector<int> ids = slot_ids(state.size());
+        Lab lab(1, "Bench Lab", "LAB", Location("Building 1"), true);
+        fill_slots(lab, ids);
+        state.start();
+        vector<Slot> slots = lab.getSlots();
+        state.stop(static_cast<long long>(slots.size())); // per slot visited
+    });
+
+    // --- A user's bookings ---
+    suite.add("User/addBooking", {10, 100, 1000}, [](BenchState& state) {
+        vector<unique_ptr<Lab>> labs;
+        for (size_t i = 1; i <= state.size(); ++i) {
+            labs.push_back(make_unique<Lab>(static_cast<int>(i), "Lab", "LAB", Location("Building 1"), true));
+        }
+        StringArena text;
+        User user(1, "bench", "password", "Student", text);
+        state.start();
+        for (const auto& lab : labs) user.addBooking(lab.get(), 1);
+        state.stop(static_cast<long long>(labs.size()));
+    });
+    suite.add("User/removeBooking", {10, 100, 1000}, [](BenchState& state) {
+        vector<unique_ptr<Lab>> labs;
+        for (size_t i = 1; i <= state.size(); ++i) {
+            labs.push_back(make_unique<Lab>(static_cast<int>(i), "Lab", "LAB", Location("Building 1"), true));
+        }
+        StringArena text;
+        User user(1, "bench", "password", "Student", text);
+        for (const auto& lab : labs) user.addBooking(lab.get(), 1);
+        vector<int> ids;
+        for (const auto& lab : labs) ids.push_back(lab->getId());
+        ids = shuffled(ids);
+        size_t removed = 0;
+        state.start();
+        for (int id : ids) removed += user.removeBooking(id, 1);
+        state.stop(static_cast<long long>(ids.size()));
+        check(removed == ids.size(), "every booking is removed");
+    });
+
+    // --- Shortest paths on a grid campus ---
+    suite.add("Map/dijkstra_shortest_path", {100, 1024, 10000}, [](BenchState& state) {
+        const NULMapGraph& campus = campus_of(state.size());
+        int side = max(2, static_cast<int>(sqrt(static_cast<double>(state.size()))));
+        vector<pair<string, string>> queries = random_grid_queries(side, side, 100);
+        state.start();
+        for (const auto& query : queries) campus.dijkstra_shortest_path(query.first, query.second);
+        state.stop(static_cast<long long>(queries.size()));
+    });
+
+    // --- Save/load round trips (ns per record) ---
+    suite.add("Storage/save_users", {1000, 10000, 100000}, [](BenchState& state) {
+        ScratchDirectory scratch;
+        clear_storage();
+        HashTable table(STORAGE_TABLE_BUCKETS);
+        make_storage_data(table, state.size(), 64);
+        state.start();
+        save_users(table);
+        state.stop(static_cast<long long>(state.size()));
+    });
+    suite.add("Storage/load_users", {1000, 10000, 100000}, [](BenchState& state) {
+        ScratchDirectory scratch;
+        clear_storage();
+        HashTable table(STORAGE_TABLE_BUCKETS);
+        make_storage_data(table, state.size(), 64);
+        save_users(table);
+        HashTable loaded(STORAGE_TABLE_BUCKETS);
+        state.start();
+        load_users(loaded);
+        state.stop(static_cast<long long>(state.size()));
+        check(loaded.getById(static_cast<int>(state.size())) != nullptr, "the last user is loaded");
+    });
+    suite.add("Storage/save_resources", {100, 1000, 10000}, [](BenchState& state) {
+        ScratchDirectory scratch;
+        clear_storage();
+        HashTable table(STORAGE_TABLE_BUCKETS);
+        make_storage_data(table, 0, state.size());
+        state.start();
+        save_resources(resources_table);
+        state.stop(static_cast<long long>(state.size()));
+    });
+    suite.add("Storage/load_resources", {100, 1000, 10000}, [](BenchState& state) {
+        ScratchDirectory scratch;
+        clear_storage();
+        HashTable table(STORAGE_TABLE_BUCKETS);
+        make_storage_data(table, 0, state.size());
+        save_resources(resources_table);
+        map<int, Resource*> loaded;
+        state.start();
+        load_resources(loaded);
+        state.stop(static_cast<long long>(state.size()));
+        check(loaded.size() == state.size(), "every resource is loaded");
+        for (auto& entry : loaded) delete entry.second;
+    });
+
+    int status = suite.run(argc, argv);
+
+    for (auto& entry : resources_table) delete entry.second;
+    resources_table.clear();
+    filesystem::remove_all(ScratchDirectory::path());
+    return status;
+}
@@ -0,0 +1,289 @@
+// Synthetic datasets for load tests: users, labs, lecture halls and buses with bookings and
+// waitlists, a campus map, and a replayable operation mix, in the formats the engine reads.
+// Build: g++ -std=c++17 -O2 -pthread Benchmarks/dataset_generator.cpp -o dataset_generator
+// Usage: ./dataset_generator <dir> [--users 20000] [--labs 400] [--halls 200] [--buses 10]
+//                            [--slots 25] [--bookings 1] [--buildings 400] [--ops 200000] [--seed 1]
+//
+// Writes <dir>/users.txt, resources.txt, campus_map.txt and operations.jsonl. Run the program
+// from <dir> with `--map campus_map.txt` to use the data, and replay the operations with
+// load_benchmark (or `main --batch operations.jsonl`).
+//
+// Users are 85% Student, 12% Lecturer and 3% Admin, named user<id> with password pw<id>. Each
+// books about --bookings resources (lab and hall slots, bus travel days); a user who finds a slot
+// taken joins that resource's waitlist. Resources stand in random buildings of a grid campus.
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+
+#include "BenchUtil.h"
+#include "../Headers/LectureHall.h"
+#include "../Headers/textfiles.h"
+
+using namespace std;
+
+// The engine's globals (main.cpp defines them in the real program)
+int next_user_id = 1;
+int next_resource_id = 1;
+map<int, Resource*> resources_table;
+
+// Bus bookings fall on days of this range
+const string BUS_FROM_DATE = "01-01-2025";
+const string BUS_TO_DATE = "31-12-2025";
+const int BUS_CAPACITY = 60;
+
+struct GeneratorOptions {
+    string dir;
+    int users = 20000;
+    int labs = 400;
+    int halls = 200;
+    int buses = 10;
+    int slots = 25;      // per lab or hall: the 7 default slots, then a weekday grid
+    int bookings = 1;    // average per user
+    int buildings = 400;
+    int ops = 200000;
+    unsigned seed = 1;
+};
+
+bool parse_options(int argc, char* argv[], GeneratorOptions& options) {
+    if (argc < 2 || argv[1][0] == '-') {
+        return false;
+    }
+    options.dir = argv[1];
+    for (int i = 2; i + 1 < argc; i += 2) {
+        string arg = argv[i];
+        int value = atoi(argv[i + 1]);
+        if (arg == "--users") options.users = value;
+        else if (arg == "--labs") options.labs = value;
+        else if (arg == "--halls") options.halls = value;
+        else if (arg == "--buses") options.buses = value;
+        else if (arg == "--slots") options.slots = max(7, value);
+        else if (arg == "--bookings") options.bookings = value;
+        else if (arg == "--buildings") options.buildings = max(4, value);
+        else if (arg == "--ops") options.ops = value;
+        else if (arg == "--seed") options.seed = static_cast<unsigned>(value);
+        else return false;
+    }
+    return argc % 2 == 0;
+}
+
+// Slot `index` (from 0) of the weekday grid: five two-hour blocks from 08:00, Monday to Friday
+Slot grid_slot(int id, int index) {
+    static const char* days[] = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday"};
+    int block = index % 5;
+    auto clock = [](int hour) { return (hour < 10 ? "0" : "") + to_string(hour) + ":00"; };
+    return Slot(id, days[(index / 5) % 5], clock(8 + 2 * block), clock(10 + 2 * block));
+}
+
+/**
+ * @brief A grid campus of about `buildings` buildings, 100 m apart, written as a map file.
+ * Returns the building names.
+ */
+vector<string> write_campus(const string& path, int buildings, mt19937& rng) {
+    int side = max(2, static_cast<int>(ceil(sqrt(static_cast<double>(buildings)))));
+    uniform_real_distribution<double> detour(1.0, 1.6);
+    ofstream out(path);
+    out << "# Generated campus: " << side << " x " << side << " buildings\n";
+    vector<string> names;
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            names.push_back(grid_node_name(r, c));
+            out << "NODE|" << grid_node_name(r, c) << "|" << c * 100 << "|" << r * 100 << "\n";
+        }
+    }
+    out << fixed << setprecision(2);
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            // 100 m at about 5 km/h is 1.2 minutes, plus a detour
+            if (c + 1 < side) out << "PATH|" << grid_node_name(r, c) << "|" << grid_node_name(r, c + 1) << "|" << 1.2 * detour(rng) << "\n";
+            if (r + 1 < side) out << "PATH|" << grid_node_name(r, c) << "|" << grid_node_name(r + 1, c) << "|" << 1.2 * detour(rng) << "\n";
+        }
+    }
+    return names;
+}
+
+int main(int argc, char* argv[]) {
+    GeneratorOptions options;
+    if (!parse_options(argc, argv, options)) {
+        cerr << "Usage: " << argv[0] << " <dir> [--users n] [--labs n] [--halls n] [--buses n] [--slots n]"
+             << " [--bookings n] [--buildings n] [--ops n] [--seed n]\n";
+        return 1;
+    }
+    engine_log.setLevel(LogLevel::Warn);
+    error_code ec;
+    filesystem::create_directories(options.dir, ec);
+    if (ec) {
+        cerr << "Could not create " << options.dir << "\n";
+        return 1;
+    }
+    filesystem::path dir(options.dir);
+    mt19937 rng(options.seed);
+    Timer timer;
+
+    // Campus
+    vector<string> buildings = write_campus((dir / "campus_map.txt").string(), options.buildings, rng);
+    uniform_int_distribution<size_t> pick_building(0, buildings.size() - 1);
+
+    // Resources: labs, then lecture halls, then buses
+    vector<Lab*> rooms;
+    vector<Bus*> buses;
+    int id = 1;
+    for (int i = 0; i < options.labs + options.halls; ++i, ++id) {
+        bool lab = i < options.labs;
+        Location location(buildings[pick_building(rng)]);
+        Lab* room = lab ? new Lab(id, "Lab " + to_string(id), "LAB", location, true)
+                        : new LectureHall(id, "Hall " + to_string(id), "LECTUREHALL", location, true);
+        for (int s = 7; s < options.slots; ++s) {
+            room->addSlot(grid_slot(s + 1, s - 7));
+        }
+        resources_table[id] = room;
+        rooms.push_back(room);
+    }
+    int first_day, last_day;
+    parse_date(BUS_FROM_DATE, first_day);
+    parse_date(BUS_TO_DATE, last_day);
+    for (int i = 0; i < options.buses; ++i, ++id) {
+        Bus* bus = new Bus(id, "Bus " + to_string(i + 1), "BUS", Location(buildings[pick_building(rng)]), true);
+        bus->setFromDate(BUS_FROM_DATE);
+        bus->setToDate(BUS_TO_DATE);
+        bus->setCapacity(BUS_CAPACITY);
+        resources_table[id] = bus;
+        buses.push_back(bus);
+    }
+
+    // Users, their bookings and the waitlists they join
+    StringArena user_text;
+    vector<unique_ptr<User>> users;
+    users.reserve(static_cast<size_t>(options.users));
+    uniform_int_distribution<int> percent(0, 99);
+    uniform_int_distribution<int> pick_slot(1, options.slots);
+    uniform_int_distribution<int> pick_day(first_day, last_day);
+    poisson_distribution<int> booking_count(options.bookings);
+    long long booked = 0, waitlisted = 0;
+    for (int u = 1; u <= options.users; ++u) {
+        int type = percent(rng);
+        const char* role = type < 85 ? "Student" : type < 97 ? "Lecturer" : "Admin";
+        users.push_back(make_unique<User>(u, "user" + to_string(u), "pw" + to_string(u), role, user_text));
+        User& user = *users.back();
+        for (int b = booking_count(rng); b > 0; --b) {
+            bool on_bus = !buses.empty() && (rooms.empty() || percent(rng) < 20);
+            if (on_bus) {
+                Bus* bus = buses[static_cast<size_t>(rng() % buses.size())];
+                int day = pick_day(rng);
+                if (bus->reserveSeat(day)) {
+                    user.loadBooking(bus, day);
+                    booked++;
+                }
+            } else if (!rooms.empty()) {
+                Lab* room = rooms[static_cast<size_t>(rng() % rooms.size())];
+                int slot = pick_slot(rng);
+                if (room->bookSlot(slot)) {
+                    user.loadBooking(room, slot);
+                    booked++;
+                } else {
+                    room->loadWaitlist(u);
+                    waitlisted++;
+                }
+            }
+        }
+    }
+
+    // The records, written by the engine's own writers
+    {
+        ofstream out(dir / RESOURCE_FILE);
+        for (const auto& entry : resources_table) {
+            write_resource_record(out, entry.second);
+            out << "\n";
+        }
+        ofstream user_out(dir / USER_FILE);
+        for (const auto& user : users) {
+            write_user_record(user_out, *user);
+            user_out << "\n";
+        }
+        if (!out || !user_out) {
+            cerr << "Could not write the data files in " << options.dir << "\n";
+            return 1;
+        }
+    }
+
+    /*
+     * Operations: sessions of random users, each starting with a login. Every line carries its
+     * user so a driver can keep each user's requests on one client, in order. The mix is 30%
+     * route, 10% nearest, 25% book, 10% cancel, 5% waitlist, 10% seats, 5% list, 5% failed logins.
+     */
+    ofstream ops(dir / "operations.jsonl");
+    vector<bool> logged_in(static_cast<size_t>(options.users) + 1, false);
+    vector<vector<pair<int, int>>> made(static_cast<size_t>(options.users) + 1); // bookings made by the ops
+    uniform_int_distribution<int> pick_user(1, max(1, options.users));
+    auto quoted = [](const string& text) { return "\"" + text + "\""; };
+    for (int n = 0; n < options.ops && options.users > 0;) {
+        int u = pick_user(rng);
+        string user = "user" + to_string(u);
+        string prefix = "{\"user\":" + quoted(user) + ",\"op\":";
+        if (!logged_in[static_cast<size_t>(u)]) {
+            ops << prefix << "\"login\",\"password\":" << quoted("pw" + to_string(u)) << "}\n";
+            logged_in[static_cast<size_t>(u)] = true;
+            n++;
+            continue;
+        }
+        int dice = percent(rng);
+        vector<pair<int, int>>& own = made[static_cast<size_t>(u)];
+        if (dice < 30) {
+            ops << prefix << "\"route\",\"from\":" << quoted(buildings[pick_building(rng)])
+                << ",\"to\":" << quoted(buildings[pick_building(rng)]) << "}\n";
+        } else if (dice < 40) {
+            ops << prefix << "\"nearest\",\"from\":" << quoted(buildings[pick_building(rng)])
+                << ",\"slot\":" << pick_slot(rng) << ",\"k\":3}\n";
+        } else if (dice < 65 || (dice < 75 && own.empty())) {
+            bool on_bus = !buses.empty() && (rooms.empty() || percent(rng) < 20);
+            if (on_bus) {
+                int bus = buses[static_cast<size_t>(rng() % buses.size())]->getId();
+                int day = pick_day(rng);
+                ops << prefix << "\"book\",\"resource\":" << bus << ",\"date\":" << quoted(format_date(day)) << "}\n";
+                own.push_back({bus, day});
+            } else if (!rooms.empty()) {
+                int room = rooms[static_cast<size_t>(rng() % rooms.size())]->getId();
+                int slot = pick_slot(rng);
+                ops << prefix << "\"book\",\"resource\":" << room << ",\"slot\":" << slot << "}\n";
+                own.push_back({room, slot});
+            } else {
+                continue;
+            }
+        } else if (dice < 75) {
+            size_t index = static_cast<size_t>(rng() % own.size());
+            pair<int, int> booking = own[index];
+            own.erase(own.begin() + static_cast<long>(index));
+            bool on_bus = dynamic_cast<Bus*>(resources_table.at(booking.first)) != nullptr;
+            ops << prefix << "\"cancel\",\"resource\":" << booking.first
+                << (on_bus ? ",\"date\":" + quoted(format_date(booking.second)) : ",\"slot\":" + to_string(booking.second)) << "}\n";
+        } else if (dice < 80) {
+            if (rooms.empty()) continue;
+            ops << prefix << "\"waitlist\",\"resource\":" << rooms[static_cast<size_t>(rng() % rooms.size())]->getId() << "}\n";
+        } else if (dice < 90) {
+            if (buses.empty()) continue;
+            int from = pick_day(rng);
+            ops << prefix << "\"seats\",\"resource\":" << buses[static_cast<size_t>(rng() % buses.size())]->getId()
+                << ",\"from\":" << quoted(format_date(from)) << ",\"to\":" << quoted(format_date(min(last_day, from + 6))) << "}\n";
+        } else if (dice < 95) {
+            ops << prefix << "\"list\"}\n";
+        } else {
+            ops << prefix << "\"login\",\"password\":\"wrong\"}\n";
+        }
+        n++;
+    }
+    if (!ops) {
+        cerr << "Could not write " << (dir / "operations.jsonl").string() << "\n";
+        return 1;
+    }
+
+    for (auto& entry : resources_table) delete entry.second;
+    resources_table.clear();
+    cout << "Wrote " << options.users << " users, " << options.labs << " labs, " << options.halls << " halls, "
+         << options.buses << " buses (" << booked << " bookings, " << waitlisted << " waitlist entries), "
+         << buildings.size() << " buildings and " << options.ops << " operations to " << options.dir
+         << " in " << fixed << setprecision(0) << timer.elapsedMs() << " ms\n";
+    return 0;
+}
@@ -0,0 +1,81 @@
+// Walk + bus journey planning: query latency of the connection scan on a synthetic campus.
+// Build: g++ -std=c++17 -O2 -pthread Benchmarks/journey_benchmark.cpp -o journey_benchmark
+// Usage: ./journey_benchmark [nodes=10000] [lines=40] [headway=5] [queries=500]
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "BenchUtil.h"
+#include "../Headers/Map.h"
+#include "../Headers/Timetable.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    int nodes = argc > 1 ? atoi(argv[1]) : 10000;
+    int lines = argc > 2 ? atoi(argv[2]) : 40;
+    double headway = argc > 3 ? atof(argv[3]) : 5.0;
+    size_t query_count = argc > 4 ? static_cast<size_t>(atoi(argv[4])) : 500;
+    int side = max(10, static_cast<int>(sqrt(static_cast<double>(nodes))));
+
+    NULMapGraph graph;
+    build_grid_campus(graph, side, side);
+    graph.freeze();
+
+    // Bus lines run straight along alternating rows and columns, stopping every 5 buildings,
+    // both directions, 06:00-22:00
+    Timer timer;
+    BusTimetable timetable;
+    mt19937 rng(11);
+    uniform_int_distribution<int> pick(0, side - 1);
+    for (int line = 0; line < lines; ++line) {
+        int fixed_coordinate = pick(rng);
+        vector<string> stops;
+        for (int i = 0; i < side; i += 5) {
+            stops.push_back(line % 2 == 0 ? grid_node_name(fixed_coordinate, i) : grid_node_name(i, fixed_coordinate));
+        }
+        vector<double> travel(stops.size() - 1, 2.5); // 5 walkways of 1-3 minutes in 2.5 minutes
+        timetable.addService(line, stops, travel, 6 * 60.0, 22 * 60.0, headway);
+        reverse(stops.begin(), stops.end());
+        timetable.addService(line, stops, travel, 6 * 60.0 + headway / 2, 22 * 60.0, headway);
+    }
+    timetable.finalize(graph);
+    double build_ms = timer.elapsedMs();
+    cout << "Synthetic campus: " << side * side << " buildings, " << timetable.stopCount() << " stops, "
+         << timetable.tripCount() << " trips, " << timetable.connectionCount() << " connections\n";
+
+    vector<pair<string, string>> queries = random_grid_queries(side, side, query_count);
+    uniform_real_distribution<double> departure(7 * 60.0, 20 * 60.0);
+    size_t with_bus = 0, inconsistent = 0;
+    double saved_minutes = 0.0, journey_ms = 0.0;
+    for (const auto& q : queries) {
+        double start = departure(rng);
+        timer.restart();
+        Journey journey = timetable.plan(graph, q.first, q.second, start, 0);
+        journey_ms += timer.elapsedMs();
+
+        // The plan must never be slower than walking, and its legs must chain in time
+        double walk = graph.shortest_route(q.first, q.second).distance;
+        if (!journey.found() || journey.arrival > start + walk + 1e-9) inconsistent++;
+        double clock = start;
+        bool rides = false;
+        for (const JourneyLeg& leg : journey.legs) {
+            if (leg.departure < clock - 1e-9) inconsistent++;
+            clock = leg.arrival;
+            rides = rides || leg.ride;
+        }
+        if (rides) with_bus++;
+        saved_minutes += start + walk - journey.arrival;
+    }
+
+    cout << fixed << setprecision(1);
+    cout << "Timetable build (sort + stop transfers): " << build_ms << " ms\n";
+    cout << setprecision(3);
+    cout << "Journey query: " << journey_ms / queries.size() << " ms/query over " << queries.size() << " queries\n";
+    cout << setprecision(1);
+    cout << "Journeys using a bus: " << with_bus << ", average saving vs walking: "
+         << saved_minutes / queries.size() << " min\n";
+    cout << "Inconsistent journeys: " << inconsistent << "\n";
+    return inconsistent == 0 ? 0 : 1;
+}
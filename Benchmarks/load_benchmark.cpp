@@ -0,0 +1,229 @@
+// End-to-end load test: replays a dataset's operations.jsonl (see dataset_generator) against
+// the engine from several clients and reports throughput and latency percentiles per op.
+// Build: g++ -std=c++17 -O2 -pthread Benchmarks/load_benchmark.cpp -o load_benchmark
+// Usage: ./load_benchmark <dir> [--clients 8] [--socket /tmp/nul.sock]
+//
+// By default the dataset in <dir> is loaded in-process (users.txt, resources.txt and
+// campus_map.txt, as `main --map campus_map.txt` run from <dir> would) and each client is a
+// thread executing requests under the same engine lock as server mode. With --socket the
+// requests go instead to a running `main --serve` started in <dir>, one connection per client.
+//
+// Each user's requests stay on one client, in file order, so logins precede their bookings.
+// Every client is closed-loop: it waits for each answer before sending its next request.
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <cstdlib>
+#include <thread>
+#include <shared_mutex>
+#include <filesystem>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "BenchUtil.h"
+#include "../Headers/textfiles.h"
+#include "../Headers/CampusRouter.h"
+#include "../Headers/Batch.h"
+
+using namespace std;
+
+// The engine's globals (main.cpp defines them in the real program)
+int next_user_id = 1;
+int next_resource_id = 1;
+map<int, Resource*> resources_table;
+
+// main.cpp's user table size, so the load sees the program's lookup costs
+const int MAIN_TABLE_BUCKETS = 10;
+
+struct ClientStats {
+    map<string, vector<double>> latencies_us; // per op
+    map<string, size_t> succeeded;
+    size_t failures = 0; // transport errors (socket mode)
+};
+
+// The request lines of each client; a user's lines all go to the same client
+vector<vector<string>> split_by_user(const string& path, size_t clients, size_t& total) {
+    vector<vector<string>> lines(clients);
+    ifstream in(path);
+    string line;
+    JsonObject fields;
+    total = 0;
+    size_t anonymous = 0;
+    while (getline(in, line)) {
+        if (line.empty() || !fields.parse(line)) continue;
+        size_t client = fields.has("user") ? hash<string>()(fields.get("user")) % clients : anonymous++ % clients;
+        lines[client].push_back(line);
+        total++;
+    }
+    return lines;
+}
+
+string op_of(const string& line) {
+    JsonObject fields;
+    return fields.parse(line) ? fields.get("op") : "";
+}
+
+bool result_ok(const string& result) {
+    return result.find("\"ok\":true") != string::npos;
+}
+
+void run_in_process(BatchProcessor& processor, shared_mutex& engine_lock, const vector<string>& lines, ClientStats& stats) {
+    SessionTable sessions;
+    string result;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        BatchRequest request;
+        request.line = static_cast<int>(i + 1);
+        request.valid = request.fields.parse(lines[i]);
+        string op = request.fields.get("op");
+        result.clear();
+        auto started = chrono::steady_clock::now();
+        if (BatchProcessor::isReadOnly(op)) {
+            shared_lock<shared_mutex> guard(engine_lock);
+            processor.execute(request, result, sessions);
+        } else {
+            unique_lock<shared_mutex> guard(engine_lock);
+            processor.execute(request, result, sessions);
+        }
+        stats.latencies_us[op].push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - started).count());
+        stats.succeeded[op] += result_ok(result);
+    }
+}
+
+void run_over_socket(const string& path, const vector<string>& lines, ClientStats& stats) {
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        stats.failures += lines.size();
+        if (fd >= 0) close(fd);
+        return;
+    }
+    string buffer;
+    char chunk[65536];
+    for (const string& line : lines) {
+        string op = op_of(line);
+        string request = line + "\n";
+        auto started = chrono::steady_clock::now();
+        if (send(fd, request.data(), request.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(request.size())) {
+            stats.failures++;
+            break;
+        }
+        size_t newline;
+        while ((newline = buffer.find('\n')) == string::npos) {
+            ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) break;
+            buffer.append(chunk, static_cast<size_t>(n));
+        }
+        if (newline == string::npos) {
+            stats.failures++;
+            break;
+        }
+        stats.latencies_us[op].push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - started).count());
+        stats.succeeded[op] += result_ok(buffer.substr(0, newline));
+        buffer.erase(0, newline + 1);
+    }
+    close(fd);
+}
+
+void print_row(const string& op, vector<double>& latencies, size_t succeeded) {
+    sort(latencies.begin(), latencies.end());
+    cout << left << setw(10) << op << right << setw(10) << latencies.size() << setw(9)
+         << 100.0 * static_cast<double>(succeeded) / static_cast<double>(max<size_t>(1, latencies.size())) << "%"
+         << setw(10) << percentile(latencies, 0.50) << setw(10) << percentile(latencies, 0.90) << setw(10)
+         << percentile(latencies, 0.99) << setw(11) << percentile(latencies, 0.999) << setw(11)
+         << (latencies.empty() ? 0.0 : latencies.back()) << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argv[1][0] == '-') {
+        cerr << "Usage: " << argv[0] << " <dir> [--clients n] [--socket path]\n";
+        return 1;
+    }
+    string dir = argv[1];
+    size_t clients = 8;
+    string socket_path;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        string arg = argv[i];
+        if (arg == "--clients") clients = max<size_t>(1, static_cast<size_t>(atol(argv[i + 1])));
+        else if (arg == "--socket") socket_path = argv[i + 1];
+    }
+    engine_log.setLevel(LogLevel::Warn);
+    engine_log.toConsole(cerr);
+
+    size_t total;
+    vector<vector<string>> lines = split_by_user((filesystem::path(dir) / "operations.jsonl").string(), clients, total);
+    if (total == 0) {
+        cerr << "No operations in " << dir << "/operations.jsonl\n";
+        return 1;
+    }
+
+    // The engine, loaded from the dataset as main.cpp loads its data files
+    HashTable user_db(MAIN_TABLE_BUCKETS);
+    NULMapGraph campus_map;
+    CampusRouter router(campus_map);
+    if (socket_path.empty()) {
+        // Labs read their slots from resources.txt when first used, so stay in the dataset
+        filesystem::current_path(dir);
+        Timer load_timer;
+        load_resources(resources_table);
+        load_users(user_db);
+        if (!campus_map.load_map("campus_map.txt", "campus_map.bin")) {
+            cerr << "Could not read " << dir << "/campus_map.txt\n";
+            return 1;
+        }
+        campus_map.freeze();
+        cout << fixed << setprecision(1) << "Loaded " << resources_table.size() << " resources and "
+             << campus_map.compiled_graph().nodeCount() << " buildings in " << load_timer.elapsedMs() << " ms\n";
+    }
+    BatchProcessor processor(user_db, resources_table, router);
+    shared_mutex engine_lock;
+
+    vector<ClientStats> stats(clients);
+    Timer timer;
+    vector<thread> threads;
+    for (size_t c = 0; c < clients; ++c) {
+        threads.emplace_back([&, c]() {
+            if (socket_path.empty()) run_in_process(processor, engine_lock, lines[c], stats[c]);
+            else run_over_socket(socket_path, lines[c], stats[c]);
+        });
+    }
+    for (thread& client : threads) client.join();
+    double wall_ms = timer.elapsedMs();
+
+    // Merge the clients' measurements
+    map<string, vector<double>> latencies;
+    map<string, size_t> succeeded;
+    vector<double> all;
+    size_t failures = 0;
+    for (ClientStats& client : stats) {
+        for (auto& entry : client.latencies_us) {
+            vector<double>& merged = latencies[entry.first];
+            merged.insert(merged.end(), entry.second.begin(), entry.second.end());
+            all.insert(all.end(), entry.second.begin(), entry.second.end());
+        }
+        for (auto& entry : client.succeeded) succeeded[entry.first] += entry.second;
+        failures += client.failures;
+    }
+
+    cout << fixed << setprecision(1);
+    cout << all.size() << " requests from " << clients << " clients " << (socket_path.empty() ? "in-process" : "over " + socket_path)
+         << " in " << wall_ms << " ms: " << static_cast<double>(all.size()) / wall_ms * 1000.0 << " requests/s\n";
+    cout << left << setw(10) << "op" << right << setw(10) << "count" << setw(10) << "ok" << setw(10) << "p50 us"
+         << setw(10) << "p90 us" << setw(10) << "p99 us" << setw(11) << "p99.9 us" << setw(11) << "max us" << "\n";
+    for (auto& entry : latencies) {
+        print_row(entry.first, entry.second, succeeded[entry.first]);
+    }
+    size_t all_ok = 0;
+    for (auto& entry : succeeded) all_ok += entry.second;
+    print_row("all", all, all_ok);
+    if (failures > 0) {
+        cout << failures << " requests got no answer\n";
+    }
+
+    for (auto& entry : resources_table) delete entry.second;
+    resources_table.clear();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+// Map loading: parsing the text map file vs. mapping the compiled graph file it leaves behind.
+// Build: g++ -std=c++17 -O2 -pthread Benchmarks/mapload_benchmark.cpp -o mapload_benchmark
+// Usage: ./mapload_benchmark [edges=1000000] [map_file=bench_map.txt]
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <cstdlib>
+#include <cstdio>
+
+#include "BenchUtil.h"
+#include "../Headers/Map.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    size_t edges = argc > 1 ? static_cast<size_t>(atol(argv[1])) : 1000000;
+    string map_file = argc > 2 ? argv[2] : "bench_map.txt";
+    string graph_file = map_file + ".bin";
+    int side = max(2, static_cast<int>(sqrt(static_cast<double>(edges) / 2.0)));
+
+    // Write a grid campus as a map file (about 2 walkways per building)
+    {
+        mt19937 rng(42);
+        uniform_real_distribution<double> walk(1.0, 3.0);
+        ofstream out(map_file);
+        out << setprecision(17);
+        for (int r = 0; r < side; ++r) {
+            for (int c = 0; c < side; ++c) {
+                out << "NODE|" << grid_node_name(r, c) << "|" << c * 100.0 << "|" << r * 100.0 << "\n";
+                if (c + 1 < side) out << "PATH|" << grid_node_name(r, c) << "|" << grid_node_name(r, c + 1) << "|" << walk(rng) << "\n";
+                if (r + 1 < side) out << "PATH|" << grid_node_name(r, c) << "|" << grid_node_name(r + 1, c) << "|" << walk(rng) << "\n";
+            }
+        }
+    }
+    remove(graph_file.c_str());
+
+    // 1. First load: parse the text, freeze, write the graph file
+    Timer timer;
+    NULMapGraph parsed;
+    if (!parsed.load_map(map_file, graph_file)) {
+        cerr << "Could not read " << map_file << "\n";
+        return 1;
+    }
+    double parse_ms = timer.elapsedMs();
+    const CSRGraph& reference = parsed.compiled_graph();
+    cout << "Map file: " << reference.nodeCount() << " buildings, " << reference.arcCount() / 2 << " walkways\n";
+
+    // 2. Later loads: map the graph file
+    timer.restart();
+    NULMapGraph mapped;
+    mapped.load_map(map_file, graph_file);
+    double map_ms = timer.elapsedMs();
+    const CSRGraph& csr = mapped.compiled_graph();
+
+    // 3. Same graph, same routes
+    size_t mismatches = csr.fingerprint() == reference.fingerprint() && csr.isMapped() ? 0 : 1;
+    SearchScratch scratch;
+    vector<pair<string, string>> queries = random_grid_queries(side, side, 50);
+    for (const auto& q : queries) {
+        Route a = parsed.shortest_route(q.first, q.second);
+        Route b = mapped.shortest_route(q.first, q.second);
+        if (fabs(a.distance - b.distance) > 1e-9 || a.path != b.path) mismatches++;
+    }
+
+    // 4. Editing a mapped map rebuilds the adjacency lists first; results must still agree
+    const auto& probe = queries.front();
+    Route before = mapped.shortest_route(probe.first, probe.second);
+    timer.restart();
+    if (before.path.size() >= 2) {
+        parsed.remove_path(before.path[0], before.path[1]);
+        mapped.remove_path(before.path[0], before.path[1]);
+    }
+    double first_edit_ms = timer.elapsedMs();
+    if (fabs(parsed.shortest_route(probe.first, probe.second).distance - mapped.shortest_route(probe.first, probe.second).distance) > 1e-9) {
+        mismatches++;
+    }
+
+    cout << fixed << setprecision(1);
+    cout << "Parse text map + write graph file: " << parse_ms << " ms\n";
+    cout << "Map graph file:                    " << setprecision(3) << map_ms << " ms\n";
+    cout << "Speedup:                           " << setprecision(0) << parse_ms / map_ms << "x\n";
+    cout << "First edit of both maps:           " << setprecision(1) << first_edit_ms << " ms\n";
+    cout << "Mismatched routes: " << mismatches << "\n";
+    remove(map_file.c_str());
+    remove(graph_file.c_str());
+    return mismatches == 0 ? 0 : 1;
+}
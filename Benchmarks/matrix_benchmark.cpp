@@ -0,0 +1,73 @@
+// Many-to-many walking-time matrix: throughput on the thread pool vs. one thread.
+// Build: g++ -std=c++17 -O2 -pthread Benchmarks/matrix_benchmark.cpp -o matrix_benchmark
+// Usage: ./matrix_benchmark [nodes=20000] [origins=1000] [destinations=1000] [csv_file]
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "BenchUtil.h"
+#include "../Headers/Map.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    int nodes = argc > 1 ? atoi(argv[1]) : 20000;
+    size_t origin_count = argc > 2 ? static_cast<size_t>(atoi(argv[2])) : 1000;
+    size_t destination_count = argc > 3 ? static_cast<size_t>(atoi(argv[3])) : 1000;
+    string csv_file = argc > 4 ? argv[4] : "";
+    int side = max(2, static_cast<int>(sqrt(static_cast<double>(nodes))));
+
+    NULMapGraph graph;
+    build_grid_campus(graph, side, side);
+    graph.freeze();
+    const CSRGraph& csr = graph.compiled_graph();
+    cout << "Synthetic campus: " << csr.nodeCount() << " nodes, " << csr.arcCount() << " arcs, "
+         << shared_thread_pool().size() << " worker threads\n";
+
+    vector<string> origins, destinations;
+    for (const auto& q : random_grid_queries(side, side, max(origin_count, destination_count))) {
+        if (origins.size() < origin_count) origins.push_back(q.first);
+        if (destinations.size() < destination_count) destinations.push_back(q.second);
+    }
+
+    // 1. Parallel matrix
+    Timer timer;
+    DistanceMatrix matrix = graph.walking_times(origins, destinations);
+    double parallel_ms = timer.elapsedMs();
+
+    // 2. Same rows on the calling thread only, for comparison (a sample if the matrix is large)
+    size_t sample = min<size_t>(origins.size(), 100);
+    vector<uint32_t> sources, targets;
+    for (size_t r = 0; r < sample; ++r) sources.push_back(csr.idOf(origins[r]));
+    for (const string& name : destinations) targets.push_back(csr.idOf(name));
+    SearchScratch scratch;
+    timer.restart();
+    for (uint32_t s : sources) {
+        csr.explore(s, scratch, [](uint32_t, double) { return false; });
+    }
+    double sequential_ms = timer.elapsedMs() * origins.size() / sample;
+
+    // 3. Spot check against point-to-point searches
+    size_t mismatches = 0;
+    for (size_t i = 0; i < 200; ++i) {
+        size_t r = (i * 7919) % matrix.rows(), c = (i * 104729) % matrix.cols();
+        NodeRoute route = csr.shortestPath(csr.idOf(origins[r]), csr.idOf(destinations[c]), scratch);
+        if (fabs(route.distance - matrix.at(r, c)) > 1e-9) mismatches++;
+    }
+
+    double pairs = static_cast<double>(matrix.rows()) * matrix.cols();
+    cout << fixed << setprecision(1);
+    cout << matrix.rows() << "x" << matrix.cols() << " matrix: " << parallel_ms << " ms ("
+         << pairs / parallel_ms * 1000.0 << " pairs/s, " << matrix.rows() / parallel_ms * 1000.0 << " rows/s)\n";
+    cout << "One thread, full searches (estimated): " << sequential_ms << " ms\n";
+    cout << "Speedup: " << sequential_ms / parallel_ms << "x\n";
+    cout << "Mismatched distances: " << mismatches << "\n";
+
+    if (!csv_file.empty()) {
+        timer.restart();
+        bool saved = matrix.saveCsv(csv_file);
+        cout << "CSV export: " << (saved ? "" : "FAILED ") << timer.elapsedMs() << " ms -> " << csv_file << "\n";
+    }
+    return mismatches == 0 ? 0 : 1;
+}
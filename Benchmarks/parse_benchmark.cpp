@@ -0,0 +1,217 @@
+// Data file parsing: the original getline/stringstream/stoi loops vs. the string_view and
+// from_chars parser (Parser.h), on the same users.txt and resources.txt, then the engine's
+// whole load_resources/load_users for comparison.
+// Build: g++ -std=c++17 -O2 -pthread Benchmarks/parse_benchmark.cpp -o parse_benchmark
+// Usage: ./parse_benchmark <dir>      (a dataset_generator directory)
+//
+// Both parsers turn every record into the values the loader keeps (ids and strings, each slot
+// and waitlist entry, each booking) but insert nothing, so the times are the parsing alone.
+// Each is the best of 5 runs and includes reading the file.
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+
+#include "BenchUtil.h"
+#include "../Headers/textfiles.h"
+
+using namespace std;
+
+// The engine's globals (main.cpp defines them in the real program)
+int next_user_id = 1;
+int next_resource_id = 1;
+map<int, Resource*> resources_table;
+
+const int RUNS = 5;
+
+// A sum over everything parsed, so both parsers can be checked against each other
+struct ParseResult {
+    long long records = 0;
+    long long checksum = 0;
+};
+
+vector<string> split_baseline(const string& text, char delim) {
+    stringstream ss(text);
+    string segment;
+    vector<string> parts;
+    while (getline(ss, segment, delim)) {
+        parts.push_back(segment);
+    }
+    return parts;
+}
+
+ParseResult baseline_users(const string& path) {
+    ParseResult result;
+    ifstream infile(path);
+    string line;
+    while (getline(infile, line)) {
+        if (line.empty()) continue;
+        vector<string> parts = split_baseline(line, '|');
+        if (parts.size() != 5) continue;
+        int id = stoi(parts[0]);
+        string name = parts[1];
+        string passwordHash = parts[2];
+        string type = parts[3];
+        result.checksum += id + name.size() + passwordHash.size() + type.size();
+        for (const string& booking : split_baseline(parts[4].substr(parts[4].find(':') + 1), ';')) {
+            if (booking.empty()) continue;
+            vector<string> ids = split_baseline(booking, ',');
+            if (ids.size() >= 2) result.checksum += stoi(ids[0]) + stoi(ids[1]);
+        }
+        result.records++;
+    }
+    return result;
+}
+
+ParseResult current_users(const string& path) {
+    ParseResult result;
+    string buffer;
+    read_file_buffer(path, buffer);
+    LineReader reader(buffer);
+    string_view line;
+    while (reader.next(line)) {
+        if (line.empty()) continue;
+        string_view parts[5];
+        int id;
+        if (split_fields(line, '|', parts, 5) != 5 || !parse_int(parts[0], id)) continue;
+        string name(parts[1]);
+        string passwordHash(parts[2]);
+        string type(parts[3]);
+        result.checksum += id + name.size() + passwordHash.size() + type.size();
+        FieldSplitter bookings(after_label(parts[4]), ';');
+        string_view booking;
+        while (bookings.next(booking)) {
+            string_view ids[2];
+            int rid, sid;
+            if (split_fields(booking, ',', ids, 2) >= 2 && parse_int(ids[0], rid) && parse_int(ids[1], sid)) {
+                result.checksum += rid + sid;
+            }
+        }
+        result.records++;
+    }
+    return result;
+}
+
+ParseResult baseline_resources(const string& path) {
+    ParseResult result;
+    ifstream infile(path);
+    string line;
+    while (getline(infile, line)) {
+        if (line.empty()) continue;
+        vector<string> parts = split_baseline(line, '|');
+        if (parts.size() < 7) continue;
+        int id = stoi(parts[0]);
+        string type = parts[1];
+        string name = parts[2];
+        string location = parts[3];
+        result.checksum += id + type.size() + name.size() + location.size();
+        if (type == "LAB" || type == "LECTUREHALL") {
+            for (const string& slot : split_baseline(parts[5].substr(parts[5].find(':') + 1), ';')) {
+                if (slot.empty()) continue;
+                vector<string> s_parts = split_baseline(slot, ',');
+                if (s_parts.size() == 5) {
+                    Slot s(stoi(s_parts[0]), s_parts[1], s_parts[2], s_parts[3]);
+                    result.checksum += s.id + (s_parts[4] == "1");
+                }
+            }
+            for (const string& user : split_baseline(parts[6].substr(parts[6].find(':') + 1), ',')) {
+                if (!user.empty()) result.checksum += stoi(user);
+            }
+        }
+        result.records++;
+    }
+    return result;
+}
+
+ParseResult current_resources(const string& path) {
+    ParseResult result;
+    string buffer;
+    read_file_buffer(path, buffer);
+    LineReader reader(buffer);
+    string_view line;
+    while (reader.next(line)) {
+        if (line.empty()) continue;
+        string_view parts[8];
+        int id;
+        if (split_fields(line, '|', parts, 8) < 7 || !parse_int(parts[0], id)) continue;
+        string type(parts[1]);
+        string name(parts[2]);
+        string location(parts[3]);
+        result.checksum += id + type.size() + name.size() + location.size();
+        if (type == "LAB" || type == "LECTUREHALL") {
+            FieldSplitter slots(after_label(parts[5]), ';');
+            string_view slot;
+            while (slots.next(slot)) {
+                string_view s_parts[5];
+                int slot_id;
+                if (split_fields(slot, ',', s_parts, 5) == 5 && parse_int(s_parts[0], slot_id)) {
+                    Slot s(slot_id, string(s_parts[1]), string(s_parts[2]), string(s_parts[3]));
+                    result.checksum += s.id + (s_parts[4] == "1");
+                }
+            }
+            FieldSplitter waitlist(after_label(parts[6]), ',');
+            string_view user;
+            int user_id;
+            while (waitlist.next(user)) {
+                if (parse_int(user, user_id)) result.checksum += user_id;
+            }
+        }
+        result.records++;
+    }
+    return result;
+}
+
+// Best time of RUNS calls to parse(path), in ms
+template <class Parse>
+double best_of(Parse parse, const string& path, ParseResult& result) {
+    double best = 0;
+    for (int run = 0; run < RUNS; ++run) {
+        Timer timer;
+        result = parse(path);
+        double ms = timer.elapsedMs();
+        if (run == 0 || ms < best) best = ms;
+    }
+    return best;
+}
+
+bool compare(const string& path, ParseResult (*baseline)(const string&), ParseResult (*current)(const string&)) {
+    ParseResult before, after;
+    double baseline_ms = best_of(baseline, path, before);
+    double current_ms = best_of(current, path, after);
+    double mb = static_cast<double>(filesystem::file_size(path)) / (1024.0 * 1024.0);
+    cout << setw(14) << filesystem::path(path).filename().string() << ": " << after.records << " records, "
+         << mb << " MB; baseline " << baseline_ms << " ms (" << mb * 1000.0 / baseline_ms << " MB/s), current "
+         << current_ms << " ms (" << mb * 1000.0 / current_ms << " MB/s), " << baseline_ms / current_ms << "x\n";
+    if (before.records != after.records || before.checksum != after.checksum) {
+        cerr << "The parsers disagree on " << path << ".\n";
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " <dir>\n";
+        return 1;
+    }
+    string dir = argv[1];
+    engine_log.setLevel(LogLevel::Warn);
+    cout << fixed << setprecision(1);
+
+    bool agree = compare(dir + "/" + RESOURCE_FILE, baseline_resources, current_resources);
+    agree = compare(dir + "/" + USER_FILE, baseline_users, current_users) && agree;
+
+    // The whole load as the engine does it: parsing, building the objects and the user table
+    filesystem::current_path(dir);
+    Timer timer;
+    load_resources(resources_table);
+    double resources_ms = timer.elapsedMs();
+    HashTable users(10);
+    timer.restart();
+    load_users(users);
+    double users_ms = timer.elapsedMs();
+    cout << "Engine load: load_resources " << resources_ms << " ms, load_users " << users_ms << " ms\n";
+    return agree ? 0 : 1;
+}
@@ -0,0 +1,57 @@
+// Routing benchmark: string-keyed Dijkstra vs. the compiled CSR graph on a synthetic campus.
+// Build: g++ -std=c++17 -O2 -pthread Benchmarks/routing_benchmark.cpp -o routing_benchmark
+// Usage: ./routing_benchmark [nodes=100000] [queries=200]
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "BenchUtil.h"
+#include "../Headers/Map.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    int nodes = argc > 1 ? atoi(argv[1]) : 100000;
+    size_t query_count = argc > 2 ? static_cast<size_t>(atoi(argv[2])) : 200;
+    int side = max(2, static_cast<int>(sqrt(static_cast<double>(nodes))));
+
+    NULMapGraph graph;
+    Timer timer;
+    build_grid_campus(graph, side, side);
+    double build_ms = timer.elapsedMs();
+
+    timer.restart();
+    graph.freeze();
+    double freeze_ms = timer.elapsedMs();
+
+    cout << "Synthetic campus: " << graph.compiled_graph().nodeCount() << " nodes, "
+         << graph.compiled_graph().arcCount() << " arcs (build " << fixed << setprecision(1)
+         << build_ms << " ms, freeze " << freeze_ms << " ms)\n";
+
+    vector<pair<string, string>> queries = random_grid_queries(side, side, query_count);
+
+    // 1. Adjacency-map Dijkstra
+    timer.restart();
+    vector<double> reference;
+    for (const auto& q : queries) {
+        reference.push_back(graph.dijkstra_on_adjacency(q.first, q.second).second);
+    }
+    double adjacency_ms = timer.elapsedMs();
+
+    // 2. CSR Dijkstra
+    timer.restart();
+    size_t mismatches = 0;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        Route route = graph.shortest_route(queries[i].first, queries[i].second);
+        if (fabs(route.distance - reference[i]) > 1e-9) mismatches++;
+    }
+    double csr_ms = timer.elapsedMs();
+
+    cout << setprecision(3);
+    cout << "Adjacency map: " << adjacency_ms / queries.size() << " ms/query\n";
+    cout << "CSR graph:     " << csr_ms / queries.size() << " ms/query\n";
+    cout << "Speedup:       " << setprecision(1) << adjacency_ms / csr_ms << "x\n";
+    cout << "Mismatched distances: " << mismatches << "\n";
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,77 @@
+// Bus seats: concurrent bookings against the per-day atomic seat counters.
+// Build: g++ -std=c++17 -O2 -pthread Benchmarks/seats_benchmark.cpp -o seats_benchmark
+// Usage: ./seats_benchmark [threads=8] [bookings_per_thread=200000] [capacity=60]
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <thread>
+
+#include "BenchUtil.h"
+#include "../Headers/Bus.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    int threads = argc > 1 ? atoi(argv[1]) : 8;
+    int per_thread = argc > 2 ? atoi(argv[2]) : 200000;
+    int capacity = argc > 3 ? atoi(argv[3]) : 60;
+
+    Bus bus(1, "Bench Bus", "BUS", Location("Bus Stop"), true);
+    bus.setFromDate("01-01-2025");
+    bus.setToDate("31-12-2025");
+    bus.setCapacity(capacity);
+    int first_day, last_day;
+    parse_date(bus.getFromDate(), first_day);
+    parse_date(bus.getToDate(), last_day);
+    int days = last_day - first_day + 1;
+
+    // Every thread books random days and cancels one in four of its own bookings
+    vector<long long> kept(threads, 0);
+    Timer timer;
+    vector<thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            mt19937 rng(static_cast<unsigned>(t) + 1);
+            uniform_int_distribution<int> pick(first_day, last_day);
+            for (int i = 0; i < per_thread; ++i) {
+                int day = pick(rng);
+                if (bus.reserveSeat(day)) {
+                    if (i % 4 == 0) bus.releaseSeat(day);
+                    else kept[t]++;
+                }
+            }
+        });
+    }
+    for (thread& worker : workers) worker.join();
+    double booking_ms = timer.elapsedMs();
+
+    // The counters must add up to exactly the bookings that were kept, and never exceed capacity
+    long long expected = 0, counted = 0;
+    size_t overfull = 0;
+    for (long long k : kept) expected += k;
+    for (int day = first_day; day <= last_day; ++day) {
+        int taken = capacity - bus.seatsLeft(day);
+        counted += taken;
+        if (taken > capacity) overfull++;
+    }
+
+    timer.restart();
+    size_t free_days = 0;
+    const int repeats = 10000;
+    for (int i = 0; i < repeats; ++i) {
+        free_days = bus.daysWithSeats(first_day, last_day).size();
+    }
+    double query_us = timer.elapsedMs() * 1000.0 / repeats;
+
+    long long attempts = static_cast<long long>(threads) * per_thread;
+    cout << fixed << setprecision(1);
+    cout << threads << " threads, " << attempts << " booking attempts over " << days << " days, "
+         << capacity << " seats per day\n";
+    cout << "Bookings: " << attempts / booking_ms / 1000.0 << " M attempts/s\n";
+    cout << "Seats taken: " << counted << " (expected " << expected << "), days with seats left: " << free_days << "\n";
+    cout << setprecision(2) << "Dates-with-seats query over the whole year: " << query_us << " us\n";
+    bool ok = counted == expected && overfull == 0;
+    cout << "Counter errors: " << (ok ? 0 : 1) << "\n";
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,247 @@
+// Server mode: throughput and latency of the epoll request server under 1, 10 and 1000 clients.
+// Build: g++ -std=c++17 -O2 -pthread Benchmarks/server_benchmark.cpp -o server_benchmark
+// Usage: ./server_benchmark [requests_per_client=200] [workers=0 (all cores)] [socket=<start one in-process>]
+//
+// Each client logs in as its own user, then sends a closed-loop mix of requests (60% route,
+// 20% list, 10% book, 10% cancel on a bus), waiting for each answer before the next request.
+// Pass the socket of a running `main --serve` to load that server instead; its users must
+// then exist (bench0, bench1, ... with password "bench").
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <thread>
+
+#include "BenchUtil.h"
+#include "../Headers/Hashtable.h"
+#include "../Headers/LectureHall.h"
+#include "../Headers/CampusRouter.h"
+#include "../Headers/Server.h"
+
+using namespace std;
+
+int next_user_id = 1001; // the engine's signup counter (main.cpp defines it in the real program)
+
+// Driver threads, each multiplexing its share of the client connections with epoll. Half the
+// cores at most, so the clients do not starve the server they are measuring.
+int driver_limit() {
+    return static_cast<int>(max(1u, min(8u, thread::hardware_concurrency() / 2)));
+}
+
+struct Client {
+    int fd = -1;
+    int user = 0;
+    int sent = 0;
+    string input;
+    chrono::steady_clock::time_point sent_at;
+};
+
+struct LoadResult {
+    size_t requests = 0;
+    size_t failures = 0;
+    double wall_ms = 0.0;
+    vector<double> latencies_us;
+};
+
+int connect_client(const string& path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0) {
+            return fd;
+        }
+        this_thread::sleep_for(chrono::milliseconds(10)); // listen backlog full; retry
+    }
+    close(fd);
+    return -1;
+}
+
+string next_request(Client& client, mt19937& rng, int side) {
+    string user = "bench" + to_string(client.user);
+    if (client.sent == 0) {
+        return "{\"op\":\"login\",\"user\":\"" + user + "\",\"password\":\"bench\"}\n";
+    }
+    int dice = static_cast<int>(rng() % 10);
+    if (dice < 6) {
+        uniform_int_distribution<int> pick(0, side - 1);
+        return "{\"op\":\"route\",\"from\":\"" + grid_node_name(pick(rng), pick(rng)) + "\",\"to\":\""
+               + grid_node_name(pick(rng), pick(rng)) + "\"}\n";
+    }
+    if (dice < 8) {
+        return "{\"op\":\"list\"}\n";
+    }
+    string date = format_date(20089 + static_cast<int>(rng() % 28)); // 01-01-2025 + up to 4 weeks
+    return string("{\"op\":\"") + (dice == 8 ? "book" : "cancel") + "\",\"user\":\"" + user
+           + "\",\"resource\":1,\"date\":\"" + date + "\"}\n";
+}
+
+bool send_all(int fd, const string& text) {
+    size_t sent = 0;
+    while (sent < text.size()) {
+        ssize_t n = send(fd, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Drives clients [first, first + count) until each has had `per_client` answers
+void drive(const string& path, int first, int count, int per_client, int side, LoadResult& result) {
+    mt19937 rng(static_cast<unsigned>(first) + 1);
+    vector<Client> clients(static_cast<size_t>(count));
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    for (int i = 0; i < count; ++i) {
+        Client& client = clients[static_cast<size_t>(i)];
+        client.user = first + i;
+        client.fd = connect_client(path);
+        if (client.fd < 0) {
+            result.failures += static_cast<size_t>(per_client);
+            continue;
+        }
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u32 = static_cast<uint32_t>(i);
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, client.fd, &event);
+        client.sent_at = chrono::steady_clock::now();
+        send_all(client.fd, next_request(client, rng, side));
+        client.sent++;
+    }
+
+    int active = 0;
+    for (const Client& client : clients) active += client.fd >= 0;
+    vector<epoll_event> events(256);
+    char buffer[65536];
+    while (active > 0) {
+        int ready = epoll_wait(epoll_fd, events.data(), static_cast<int>(events.size()), 5000);
+        if (ready <= 0) {
+            break; // server stopped answering
+        }
+        for (int e = 0; e < ready; ++e) {
+            Client& client = clients[events[e].data.u32];
+            ssize_t n = recv(client.fd, buffer, sizeof(buffer), 0);
+            if (n <= 0) {
+                epoll_ctl(epoll_fd, EPOLL_CTL_DEL, client.fd, nullptr);
+                result.failures += static_cast<size_t>(per_client + 1 - client.sent);
+                active--;
+                continue;
+            }
+            client.input.append(buffer, static_cast<size_t>(n));
+            size_t newline = client.input.find('\n');
+            if (newline == string::npos) {
+                continue;
+            }
+            // One request is in flight per client, so one complete line is its answer
+            auto now = chrono::steady_clock::now();
+            result.latencies_us.push_back(chrono::duration<double, micro>(now - client.sent_at).count());
+            result.requests++;
+            if (client.input.compare(0, newline, "{\"line\":1,\"op\":\"login\",\"ok\":true,\"status\":\"ok\"}") != 0
+                && client.sent == 1) {
+                result.failures++; // login failed; everything after it would be not_logged_in
+            }
+            client.input.erase(0, newline + 1);
+            if (client.sent > per_client) {
+                epoll_ctl(epoll_fd, EPOLL_CTL_DEL, client.fd, nullptr);
+                active--;
+                continue;
+            }
+            client.sent_at = chrono::steady_clock::now();
+            send_all(client.fd, next_request(client, rng, side));
+            client.sent++;
+        }
+    }
+    for (Client& client : clients) {
+        if (client.fd >= 0) close(client.fd);
+    }
+    close(epoll_fd);
+}
+
+LoadResult run_load(const string& path, int clients, int per_client, int side) {
+    int drivers = min(clients, driver_limit());
+    vector<LoadResult> results(static_cast<size_t>(drivers));
+    vector<thread> threads;
+    Timer timer;
+    for (int d = 0; d < drivers; ++d) {
+        int first = clients * d / drivers;
+        int last = clients * (d + 1) / drivers;
+        threads.emplace_back(drive, cref(path), first, last - first, per_client, side, ref(results[static_cast<size_t>(d)]));
+    }
+    for (thread& t : threads) t.join();
+
+    LoadResult total;
+    total.wall_ms = timer.elapsedMs();
+    for (LoadResult& r : results) {
+        total.requests += r.requests;
+        total.failures += r.failures;
+        total.latencies_us.insert(total.latencies_us.end(), r.latencies_us.begin(), r.latencies_us.end());
+    }
+    sort(total.latencies_us.begin(), total.latencies_us.end());
+    return total;
+}
+
+int main(int argc, char* argv[]) {
+    int per_client = argc > 1 ? atoi(argv[1]) : 200;
+    size_t worker_count = argc > 2 ? static_cast<size_t>(atol(argv[2])) : 0;
+    string path = argc > 3 ? argv[3] : "";
+    const int side = 30;
+    const int client_counts[] = {1, 10, 1000};
+
+    // Only this benchmark's report is printed, not the engine's booking events
+    engine_log.setLevel(LogLevel::Warn);
+
+    // In-process server over a synthetic campus with one bus and a few lecture halls
+    NULMapGraph graph;
+    build_grid_campus(graph, side, side);
+    graph.freeze();
+    CampusRouter router(graph);
+    HashTable user_db(1024);
+    for (int i = 0; i < 1000; ++i) {
+        user_db.insert(i + 1, "bench" + to_string(i), "bench", "Student");
+    }
+    map<int, Resource*> resources;
+    Bus* bus = new Bus(1, "Bench Bus", "BUS", Location(grid_node_name(0, 0)), true);
+    bus->setFromDate("01-01-2025");
+    bus->setToDate("31-12-2025");
+    bus->setCapacity(65535);
+    resources[1] = bus;
+    for (int id = 2; id <= 10; ++id) {
+        resources[id] = new LectureHall(id, "Hall " + to_string(id), "LECTUREHALL", Location(grid_node_name(id, id)), true);
+    }
+    BatchProcessor processor(user_db, resources, router);
+
+    unique_ptr<RequestServer> server;
+    thread server_thread;
+    if (path.empty()) {
+        path = "/tmp/nul_server_benchmark." + to_string(getpid()) + ".sock";
+        server = make_unique<RequestServer>(processor, worker_count);
+        if (!server->listen(path)) {
+            cerr << "Could not listen on " << path << "\n";
+            return 1;
+        }
+        cout << "In-process server on " << path << " with " << server->workerCount() << " workers, "
+             << side * side << "-building campus\n";
+        server_thread = thread([&]() { server->run(); });
+    } else {
+        cout << "Loading the server on " << path << "\n";
+    }
+
+    cout << fixed << setprecision(1);
+    size_t failures = 0;
+    for (int clients : client_counts) {
+        LoadResult result = run_load(path, clients, per_client, side);
+        failures += result.failures;
+        cout << setw(5) << clients << " clients: " << setw(8) << result.requests / result.wall_ms * 1000.0
+             << " requests/s, p50 " << setw(8) << percentile(result.latencies_us, 0.50) << " us, p99 " << setw(8)
+             << percentile(result.latencies_us, 0.99) << " us (" << result.requests << " requests, "
+             << result.failures << " failed)\n";
+    }
+
+    if (server) {
+        server->stop();
+        server_thread.join();
+    }
+    for (auto& entry : resources) delete entry.second;
+    cout << "Failed requests: " << failures << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+// Dialogue sessions: memory per idle coroutine session and the cost of a booking dialogue.
+// Build: g++ -std=c++20 -O2 -pthread Benchmarks/session_benchmark.cpp -o session_benchmark
+// Usage: ./session_benchmark [sessions=5000] [loops=2]
+//
+// Opens the sessions against an in-process SessionServer, logs each one in and leaves it idle
+// at the menu prompt, then has every session book a bus seat and quit.
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <thread>
+#include <malloc.h>
+
+#include "BenchUtil.h"
+#include "../Headers/Hashtable.h"
+#include "../Headers/LectureHall.h"
+#include "../Headers/Session.h"
+
+using namespace std;
+
+int next_user_id = 1; // the engine's signup counter (main.cpp defines it in the real program)
+
+const string MENU_PROMPT = "Enter your choice: ";
+
+size_t heap_in_use() {
+    return mallinfo2().uordblks;
+}
+
+// Reads from a blocking socket until the text ends with `suffix`; false if the server hung up
+bool read_until(int fd, const string& suffix, string& text) {
+    text.clear();
+    char buffer[4096];
+    while (text.size() < suffix.size() || text.compare(text.size() - suffix.size(), suffix.size(), suffix) != 0) {
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) return false;
+        text.append(buffer, static_cast<size_t>(n));
+    }
+    return true;
+}
+
+bool send_text(int fd, const string& text) {
+    return send(fd, text.data(), text.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(text.size());
+}
+
+int main(int argc, char* argv[]) {
+    int sessions = argc > 1 ? atoi(argv[1]) : 5000;
+    size_t loop_count = argc > 2 ? static_cast<size_t>(atol(argv[2])) : 2;
+
+    // Only this benchmark's report is printed, not the engine's booking events
+    engine_log.setLevel(LogLevel::Warn);
+
+    HashTable user_db(4096);
+    for (int i = 0; i < sessions; ++i) {
+        user_db.insert(next_user_id++, "bench" + to_string(i), "bench", "Student");
+    }
+    map<int, Resource*> resources;
+    for (int id = 1; id <= 6; ++id) {
+        resources[id] = new LectureHall(id, "Hall " + to_string(id), "LECTUREHALL", Location("Building " + to_string(id)), true);
+    }
+    Bus* bus = new Bus(7, "Bench Bus", "BUS", Location("Bus Stop"), true);
+    bus->setFromDate("01-01-2025");
+    bus->setToDate("31-12-2025");
+    bus->setCapacity(65535);
+    resources[7] = bus;
+
+    string path = "/tmp/nul_session_benchmark." + to_string(getpid()) + ".sock";
+    SessionServer server(user_db, resources, loop_count);
+    if (!server.listen(path)) {
+        cerr << "Could not listen on " << path << "\n";
+        return 1;
+    }
+    thread server_thread([&]() { server.run(); });
+
+    vector<int> fds(static_cast<size_t>(sessions), -1);
+    string text;
+    text.reserve(1 << 16);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    this_thread::sleep_for(chrono::milliseconds(50)); // let the loops settle before the baseline
+    size_t heap_before = heap_in_use();
+
+    // Log every session in and leave it waiting at the menu
+    size_t failures = 0;
+    Timer timer;
+    for (int i = 0; i < sessions; ++i) {
+        int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+            || !send_text(fd, "bench" + to_string(i) + "\nbench\n") || !read_until(fd, MENU_PROMPT, text)
+            || text.find("Login successful") == string::npos) {
+            failures++;
+        }
+        fds[static_cast<size_t>(i)] = fd;
+    }
+    double login_ms = timer.elapsedMs();
+    while (server.sessionCount() < static_cast<size_t>(sessions) && failures == 0) {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    double heap_per_session = static_cast<double>(heap_in_use() - heap_before) / sessions;
+    double frames_per_session = static_cast<double>(session_frame_bytes.load()) / sessions;
+
+    // One booking dialogue per session: menu choice, resource, travel date
+    timer.restart();
+    for (int i = 0; i < sessions; ++i) {
+        int fd = fds[static_cast<size_t>(i)];
+        string date = format_date(20089 + i % 300);
+        if (!send_text(fd, "2\n7\n" + date + "\n") || !read_until(fd, MENU_PROMPT, text)
+            || text.find("Successfully booked a seat") == string::npos) {
+            failures++;
+        }
+    }
+    double booking_ms = timer.elapsedMs();
+
+    // Quit every session; the server must close them and free every frame
+    for (int fd : fds) {
+        if (!send_text(fd, "5\n") || !read_until(fd, "Goodbye!\n", text)) failures++;
+        char byte;
+        if (recv(fd, &byte, 1, 0) != 0) failures++; // connection closed after the goodbye
+        close(fd);
+    }
+    for (int wait = 0; wait < 1000 && server.sessionCount() > 0; ++wait) {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    size_t frames_left = session_frame_bytes.load();
+
+    server.stop();
+    server_thread.join();
+    for (auto& entry : resources) delete entry.second;
+
+    cout << fixed << setprecision(1);
+    cout << sessions << " sessions on " << server.loopCount() << " event loops\n";
+    cout << "Connect + login: " << login_ms * 1000.0 / sessions << " us/session\n";
+    cout << "Idle session memory: " << heap_per_session << " bytes of heap, of which "
+         << frames_per_session << " bytes of coroutine frames\n";
+    cout << "Booking dialogue (3 prompts): " << booking_ms * 1000.0 / sessions << " us/session\n";
+    cout << "Frames left after quitting: " << frames_left << " bytes\n";
+    cout << "Failed sessions: " << failures << "\n";
+    return failures == 0 && frames_left == 0 ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+// Walkway closures, reopenings and reweights on a map with a precomputed route table: targeted repair of the
+// affected rows vs. rebuilding the whole table.
+// Build: g++ -std=c++17 -O2 -pthread Benchmarks/update_benchmark.cpp -o update_benchmark
+// Usage: ./update_benchmark [nodes=1500] [updates=100]
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "BenchUtil.h"
+#include "../Headers/Map.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    int nodes = argc > 1 ? atoi(argv[1]) : 1500;
+    int update_count = argc > 2 ? atoi(argv[2]) : 100;
+    int side = max(2, static_cast<int>(sqrt(static_cast<double>(nodes))));
+
+    NULMapGraph graph;
+    build_grid_campus(graph, side, side);
+    graph.freeze();
+    const CSRGraph& csr = graph.compiled_graph();
+
+    Timer timer;
+    graph.precompute_routes(csr.nodeCount());
+    double full_ms = timer.elapsedMs();
+    cout << "Synthetic campus: " << csr.nodeCount() << " nodes; full route table build " << fixed
+         << setprecision(1) << full_ms << " ms\n";
+
+    // Mix of closures, reopenings, slowdowns and speedups on random grid walkways
+    mt19937 rng(11);
+    uniform_int_distribution<int> cell(0, side - 2);
+    uniform_int_distribution<int> kind(0, 3);
+    vector<pair<pair<string, string>, double>> closed; // walkway and its weight before closing
+    double repair_ms = 0.0;
+    int applied = 0, reopened = 0;
+    for (int i = 0; i < update_count; ++i) {
+        int change = kind(rng);
+        if (change == 3 && !closed.empty()) {
+            auto walkway = closed.back();
+            closed.pop_back();
+            timer.restart();
+            bool ok = graph.set_path_weight(walkway.first.first, walkway.first.second, walkway.second);
+            repair_ms += timer.elapsedMs();
+            applied++;
+            reopened += ok;
+            continue;
+        }
+        int r = cell(rng), c = cell(rng);
+        string u = grid_node_name(r, c);
+        string v = (i % 2 == 0) ? grid_node_name(r, c + 1) : grid_node_name(r + 1, c);
+        double weight = graph.get_edge_weight(u, v);
+        if (weight == INF) continue;
+
+        timer.restart();
+        switch (change) {
+            case 0:
+                graph.remove_path(u, v);
+                closed.push_back({{u, v}, weight});
+                break;
+            case 1: graph.set_path_weight(u, v, weight * 3.0); break;
+            default: graph.set_path_weight(u, v, weight * 0.3); break;
+        }
+        repair_ms += timer.elapsedMs();
+        applied++;
+    }
+
+    // Check the repaired table against plain searches on the updated graph
+    SearchScratch scratch;
+    size_t mismatches = 0;
+    vector<pair<string, string>> queries = random_grid_queries(side, side, 2000);
+    for (const auto& q : queries) {
+        Route table_route = graph.shortest_route(q.first, q.second);
+        NodeRoute reference = csr.shortestPath(csr.idOf(q.first), csr.idOf(q.second), scratch);
+        bool both_missing = !table_route.found() && !reference.found();
+        if (!both_missing && fabs(table_route.distance - reference.distance) > 1e-4 * max(1.0, reference.distance)) {
+            mismatches++;
+        }
+    }
+
+    cout << setprecision(2);
+    cout << "Updates applied: " << applied << " (" << reopened << " closed walkways reopened)\n";
+    cout << "Targeted repair: " << repair_ms / applied << " ms/update\n";
+    cout << "Full rebuild:    " << full_ms << " ms/update\n";
+    cout << "Speedup:         " << setprecision(1) << full_ms * applied / repair_ms << "x\n";
+    cout << "Mismatched distances: " << mismatches << "\n";
+    return mismatches == 0 ? 0 : 1;
+}
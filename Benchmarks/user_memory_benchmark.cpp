@@ -0,0 +1,98 @@
+// Heap bytes per user in the user table, idle and with a few bookings each, and per idle lab.
+// Build: g++ -std=c++17 -O2 -pthread Benchmarks/user_memory_benchmark.cpp -o user_memory_benchmark
+// Usage: ./user_memory_benchmark [users=1000000] [labs=100000]
+//
+// Heap use is read from malloc's statistics (glibc) before and after each step, so every
+// block counts with its allocator overhead. The table's bucket array is allocated beforehand
+// and not counted.
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <memory>
+#include <malloc.h>
+
+#include "BenchUtil.h"
+#include "../Headers/Hashtable.h"
+#include "../Headers/LectureHall.h"
+
+using namespace std;
+
+// The engine's globals (main.cpp defines them in the real program)
+int next_user_id = 1;
+int next_resource_id = 1;
+map<int, Resource*> resources_table;
+
+// Buckets for the user table: enough for short chains at a million users
+const int USER_TABLE_BUCKETS = 1 << 20;
+// Labs the bookings point at
+const int BOOKED_LABS = 64;
+
+size_t heap_in_use() {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+int main(int argc, char* argv[]) {
+    int users = argc > 1 ? atoi(argv[1]) : 1000000;
+    int labs = argc > 2 ? atoi(argv[2]) : 100000;
+
+    // Only this benchmark's report is printed, not the engine's sign-up and booking events
+    engine_log.setLevel(LogLevel::Warn);
+
+    vector<unique_ptr<Lab>> booked;
+    for (int i = 1; i <= BOOKED_LABS; ++i) {
+        booked.push_back(make_unique<Lab>(i, "Lab " + to_string(i), "LAB", Location("Building 1"), true));
+    }
+    vector<string> names;
+    names.reserve(static_cast<size_t>(users));
+    for (int i = 0; i < users; ++i) {
+        names.push_back("student" + to_string(i));
+    }
+
+    HashTable table(USER_TABLE_BUCKETS);
+    user_changes().clear();
+
+    // Users without bookings, as after sign-up
+    size_t before = heap_in_use();
+    Timer timer;
+    for (int i = 0; i < users; ++i) {
+        table.insert(i + 1, names[static_cast<size_t>(i)], "pw" + to_string(i * 7919 % 100000), i % 10 ? "Student" : "Lecturer");
+    }
+    double insert_ms = timer.elapsedMs();
+    size_t idle = heap_in_use();
+
+    // 0-4 bookings per user (2 on average), the common range
+    int bookings = 0;
+    for (int i = 0; i < users; ++i) {
+        User* user = table.get(names[static_cast<size_t>(i)]);
+        for (int b = 0; b < i % 5; ++b, ++bookings) {
+            user->loadBooking(booked[static_cast<size_t>((i + b) % BOOKED_LABS)].get(), b + 1);
+        }
+    }
+    size_t with_bookings = heap_in_use();
+
+    timer.restart();
+    size_t found = 0;
+    for (const string& name : names) found += table.get(name) != nullptr;
+    double lookup_ms = timer.elapsedMs();
+
+    // Labs as the loader creates them, before their slots are first used
+    vector<Lab*> rooms;
+    rooms.reserve(static_cast<size_t>(labs));
+    size_t rooms_before = heap_in_use();
+    for (int i = 0; i < labs; ++i) {
+        rooms.push_back(new LectureHall(i + 1, "Hall", "LECTUREHALL", Location("Building 1"), true));
+    }
+    size_t labs_after = heap_in_use();
+
+    cout << fixed << setprecision(1);
+    cout << users << " users, " << bookings << " bookings\n";
+    cout << "Idle user:            " << static_cast<double>(idle - before) / users << " bytes/user\n";
+    cout << "With 0-4 bookings:    " << static_cast<double>(with_bookings - before) / users << " bytes/user\n";
+    cout << "Idle lecture hall:    " << static_cast<double>(labs_after - rooms_before) / max(1, labs) << " bytes/hall\n";
+    cout << "Insert: " << insert_ms * 1e6 / users << " ns/user, lookup: " << lookup_ms * 1e6 / users << " ns/user\n";
+
+    for (Lab* room : rooms) delete room;
+    return found == static_cast<size_t>(users) ? 0 : 1;
+}
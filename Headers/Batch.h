@@ -0,0 +1,463 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <iomanip>
+#include <future>
+#include <cstdio>
+
+#include "Hashtable.h"
+#include "User.h"
+#include "Resource.h"
+#include "Map.h"
+#include "CampusRouter.h"
+#include "Nearby.h"
+#include "Timetable.h"
+#include "Engine.h"
+#include "Parser.h"
+#include "ThreadPool.h"
+#include "Trace.h"
+
+using namespace std;
+
+// Number of request lines parsed and executed together
+const size_t BATCH_SIZE = 4096;
+
+/**
+ * @brief A flat JSON object ({"key": value, ...}) as used by the batch request format.
+ * Values are kept as text: strings are unescaped, numbers/true/false/null are kept verbatim.
+ * Nested objects and arrays are rejected.
+ */
+class JsonObject {
+private:
+    vector<pair<string, string>> fields;
+
+    static void skipSpace(string_view text, size_t& pos) {
+        while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\r' || text[pos] == '\n')) {
+            pos++;
+        }
+    }
+
+    static bool parseString(string_view text, size_t& pos, string& out) {
+        if (pos >= text.size() || text[pos] != '"') return false;
+        pos++;
+        out.clear();
+        while (pos < text.size()) {
+            char c = text[pos++];
+            if (c == '"') return true;
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (pos >= text.size()) return false;
+            char e = text[pos++];
+            switch (e) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    // Only the ASCII range is decoded; other code points become '?'
+                    if (pos + 4 > text.size()) return false;
+                    int code;
+                    auto result = from_chars(text.data() + pos, text.data() + pos + 4, code, 16);
+                    if (result.ptr != text.data() + pos + 4) return false;
+                    out += (code < 0x80) ? static_cast<char>(code) : '?';
+                    pos += 4;
+                    break;
+                }
+                default: return false;
+            }
+        }
+        return false;
+    }
+
+public:
+    /**
+     * @brief Parses one JSON line. Returns false if it is not a flat JSON object.
+     */
+    bool parse(string_view text) {
+        fields.clear();
+        size_t pos = 0;
+        skipSpace(text, pos);
+        if (pos >= text.size() || text[pos] != '{') return false;
+        pos++;
+        skipSpace(text, pos);
+        if (pos < text.size() && text[pos] == '}') {
+            pos++;
+        } else {
+            while (true) {
+                string key, value;
+                skipSpace(text, pos);
+                if (!parseString(text, pos, key)) return false;
+                skipSpace(text, pos);
+                if (pos >= text.size() || text[pos] != ':') return false;
+                pos++;
+                skipSpace(text, pos);
+                if (pos >= text.size()) return false;
+                if (text[pos] == '"') {
+                    if (!parseString(text, pos, value)) return false;
+                } else if (text[pos] == '{' || text[pos] == '[') {
+                    return false;
+                } else {
+                    size_t end = text.find_first_of(",} \t\r\n", pos);
+                    if (end == string_view::npos) return false;
+                    value = string(text.substr(pos, end - pos));
+                    pos = end;
+                }
+                fields.push_back({move(key), move(value)});
+                skipSpace(text, pos);
+                if (pos < text.size() && text[pos] == ',') { pos++; continue; }
+                if (pos < text.size() && text[pos] == '}') { pos++; break; }
+                return false;
+            }
+        }
+        skipSpace(text, pos);
+        return pos == text.size();
+    }
+
+    bool has(const string& key) const {
+        for (const auto& field : fields) {
+            if (field.first == key) return true;
+        }
+        return false;
+    }
+
+    string get(const string& key, const string& fallback = "") const {
+        for (const auto& field : fields) {
+            if (field.first == key) return field.second;
+        }
+        return fallback;
+    }
+
+    bool getInt(const string& key, int& value) const {
+        for (const auto& field : fields) {
+            if (field.first == key) return parse_int(field.second, value);
+        }
+        return false;
+    }
+};
+
+/**
+ * @brief Appends a JSON string literal (with quotes) to out.
+ */
+void append_json_string(string& out, string_view text) {
+    out += '"';
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+/**
+ * @brief One parsed request line of a batch.
+ */
+struct BatchRequest {
+    int line;
+    bool valid;
+    JsonObject fields;
+};
+
+// Logged-in users of one client (a batch file or a server connection): username -> user
+using SessionTable = map<string, User*>;
+
+/**
+ * @brief Executes JSON-lines requests against the engine without prompts.
+ *
+ * Requests: {"op":"signup","user":U,"password":P}
+ *           {"op":"login","user":U,"password":P}
+ *           {"op":"book","user":U,"resource":R,"slot":S}     (buses: "date":"DD-MM-YYYY" instead of slot)
+ *           {"op":"cancel","user":U,"resource":R,"slot":S}   (buses: "date", or neither for all)
+ *           {"op":"seats","resource":R,"from":"DD-MM-YYYY","to":"DD-MM-YYYY"}  (bus dates with seats)
+ *           {"op":"waitlist","user":U,"resource":R}
+ *           {"op":"route","from":A,"to":B}                    (buildings or rooms)
+ *           {"op":"nearest","from":A,"slot":S,"k":K,"type":T}  (k defaults to 3, type optional)
+ *           {"op":"journey","from":A,"to":B,"date":"DD-MM-YYYY","depart":"HH:MM"}  (walking and buses)
+ *           {"op":"list"}                                    (all resources)
+ * Every request may carry an "id" that is echoed in its result. Booking operations need a prior
+ * successful login of the same user in the batch, just as the menu needs a logged-in user.
+ * Result: {"line":N,"id":...,"op":...,"ok":true|false,"status":...} plus op-specific fields.
+ */
+class BatchProcessor {
+private:
+    HashTable& user_db;
+    map<int, Resource*>& resources;
+    const CampusRouter& router;
+    ResourceLocator locator;
+    const BusTimetable* timetable;
+    SessionTable sessions; // used by run() and execute() without a session table
+
+    User* sessionUser(const BatchRequest& request, string& result, SessionTable& table);
+    void appendStatus(string& result, EngineStatus status);
+
+public:
+    BatchProcessor(HashTable& user_db, map<int, Resource*>& resources, const CampusRouter& router,
+                   const BusTimetable* timetable = nullptr)
+        : user_db(user_db), resources(resources), router(router), locator(resources), timetable(timetable) {}
+
+    // Executes one request and appends its JSON result line (with newline) to out
+    void execute(const BatchRequest& request, string& out) { execute(request, out, sessions); }
+    void execute(const BatchRequest& request, string& out, SessionTable& table);
+
+    /**
+     * @brief Whether an op only reads engine state, so several can run at once (the server
+     * takes a shared lock for these and an exclusive one for everything else).
+     */
+    static bool isReadOnly(const string& op) {
+        return op == "route" || op == "journey" || op == "seats" || op == "list";
+    }
+
+    // Streams requests from in and writes one result per request to out. Returns the request count.
+    size_t run(istream& in, ostream& out);
+};
+
+void BatchProcessor::appendStatus(string& result, EngineStatus status) {
+    result += status == EngineStatus::Ok ? ",\"ok\":true,\"status\":" : ",\"ok\":false,\"status\":";
+    append_json_string(result, status_name(status));
+}
+
+User* BatchProcessor::sessionUser(const BatchRequest& request, string& result, SessionTable& table) {
+    auto it = table.find(request.fields.get("user"));
+    if (it == table.end()) {
+        result += ",\"ok\":false,\"status\":\"not_logged_in\"";
+        return nullptr;
+    }
+    return it->second;
+}
+
+void BatchProcessor::execute(const BatchRequest& request, string& out, SessionTable& table) {
+    string result = "{\"line\":" + to_string(request.line);
+    if (!request.valid) {
+        out += result + ",\"ok\":false,\"status\":\"malformed_request\"}\n";
+        return;
+    }
+
+    const JsonObject& fields = request.fields;
+    if (fields.has("id")) {
+        result += ",\"id\":";
+        append_json_string(result, fields.get("id"));
+    }
+    string op = fields.get("op");
+    TraceSpan span("request", "execute", op);
+    result += ",\"op\":";
+    append_json_string(result, op);
+
+    int rid = 0;
+    int sid = -1;
+    bool needs_resource = (op == "book" || op == "cancel" || op == "waitlist" || op == "seats");
+    if (needs_resource && (!fields.getInt("resource", rid) || (fields.has("slot") && !fields.getInt("slot", sid))
+                           || (fields.has("date") && !parse_date(fields.get("date"), sid)))) {
+        out += result + ",\"ok\":false,\"status\":\"invalid_arguments\"}\n";
+        return;
+    }
+
+    if (op == "signup") {
+        appendStatus(result, signup_user(user_db, fields.get("user"), fields.get("password")));
+    } else if (op == "login") {
+        User* user = user_db.login(fields.get("user"), fields.get("password"));
+        if (user) {
+            table[string(user->getName())] = user;
+        }
+        appendStatus(result, user ? EngineStatus::Ok : EngineStatus::InvalidCredentials);
+    } else if (op == "book") {
+        if (User* user = sessionUser(request, result, table)) {
+            appendStatus(result, book_resource(resources, user, rid, sid));
+        }
+    } else if (op == "cancel") {
+        if (User* user = sessionUser(request, result, table)) {
+            appendStatus(result, cancel_booking(resources, user, rid, sid));
+        }
+    } else if (op == "waitlist") {
+        if (User* user = sessionUser(request, result, table)) {
+            appendStatus(result, join_waitlist(resources, user, rid));
+        }
+    } else if (op == "seats") {
+        auto it = resources.find(rid);
+        Bus* bus = it == resources.end() ? nullptr : dynamic_cast<Bus*>(it->second);
+        int from_day, to_day;
+        if (!bus) {
+            appendStatus(result, it == resources.end() ? EngineStatus::ResourceNotFound : EngineStatus::NotSupported);
+        } else if (!parse_date(fields.get("from", bus->getFromDate()), from_day) || !parse_date(fields.get("to", bus->getToDate()), to_day)) {
+            result += ",\"ok\":false,\"status\":\"invalid_arguments\"";
+        } else {
+            result += ",\"ok\":true,\"status\":\"ok\",\"capacity\":" + to_string(bus->getCapacity()) + ",\"dates\":[";
+            vector<int> days = bus->daysWithSeats(from_day, to_day);
+            for (size_t i = 0; i < days.size(); ++i) {
+                if (i > 0) result += ',';
+                result += "{\"date\":";
+                append_json_string(result, format_date(days[i]));
+                result += ",\"seats\":" + to_string(bus->seatsLeft(days[i])) + "}";
+            }
+            result += ']';
+        }
+    } else if (op == "list") {
+        result += ",\"ok\":true,\"status\":\"ok\",\"resources\":[";
+        bool first = true;
+        for (const auto& entry : resources) {
+            const Resource* resource = entry.second;
+            if (!first) result += ',';
+            first = false;
+            result += "{\"id\":" + to_string(resource->getId()) + ",\"name\":";
+            append_json_string(result, resource->getName());
+            result += ",\"type\":";
+            append_json_string(result, resource->getType());
+            result += ",\"location\":";
+            append_json_string(result, resource->getLocation().getName());
+            result += '}';
+        }
+        result += ']';
+    } else if (op == "route") {
+        string from = fields.get("from");
+        string to = fields.get("to");
+        if (!router.knows(from) || !router.knows(to)) {
+            result += ",\"ok\":false,\"status\":\"unknown_location\"";
+        } else {
+            Route route = router.route(from, to);
+            if (!route.found()) {
+                result += ",\"ok\":false,\"status\":\"no_path\"";
+            } else {
+                ostringstream distance;
+                distance << fixed << setprecision(1) << route.distance;
+                result += ",\"ok\":true,\"status\":\"ok\",\"minutes\":" + distance.str() + ",\"path\":[";
+                for (size_t i = 0; i < route.path.size(); ++i) {
+                    if (i > 0) result += ',';
+                    append_json_string(result, route.path[i]);
+                }
+                result += ']';
+            }
+        }
+    } else if (op == "nearest") {
+        string from = fields.get("from");
+        int k = 3;
+        if (!fields.getInt("slot", sid) || (fields.has("k") && (!fields.getInt("k", k) || k < 0))) {
+            result += ",\"ok\":false,\"status\":\"invalid_arguments\"";
+        } else if (!router.knows(from)) {
+            result += ",\"ok\":false,\"status\":\"unknown_location\"";
+        } else {
+            vector<NearbyResource> nearby = nearest_free_resources(router.campusMap(), locator, router.buildingOf(from),
+                                                                   sid, static_cast<size_t>(k), fields.get("type"));
+            result += ",\"ok\":true,\"status\":\"ok\",\"results\":[";
+            for (size_t i = 0; i < nearby.size(); ++i) {
+                ostringstream minutes;
+                minutes << fixed << setprecision(1) << nearby[i].minutes;
+                if (i > 0) result += ',';
+                result += "{\"resource\":" + to_string(nearby[i].resource->getId()) + ",\"name\":";
+                append_json_string(result, nearby[i].resource->getName());
+                result += ",\"building\":";
+                append_json_string(result, nearby[i].resource->getLocation().getName());
+                result += ",\"minutes\":" + minutes.str() + "}";
+            }
+            result += ']';
+        }
+    } else if (op == "journey" && timetable) {
+        string from = fields.get("from");
+        string to = fields.get("to");
+        double departure;
+        int day;
+        if (!parse_date(fields.get("date"), day) || !parse_clock_time(fields.get("depart"), departure)) {
+            result += ",\"ok\":false,\"status\":\"invalid_arguments\"";
+        } else if (!router.campusMap().has_node(from) || !router.campusMap().has_node(to)) {
+            result += ",\"ok\":false,\"status\":\"unknown_location\"";
+        } else {
+            Journey journey = timetable->plan(router.campusMap(), from, to, departure, day);
+            if (!journey.found()) {
+                result += ",\"ok\":false,\"status\":\"no_path\"";
+            } else {
+                result += ",\"ok\":true,\"status\":\"ok\",\"arrive\":";
+                append_json_string(result, format_clock_time(journey.arrival));
+                result += ",\"legs\":[";
+                for (size_t i = 0; i < journey.legs.size(); ++i) {
+                    const JourneyLeg& leg = journey.legs[i];
+                    if (i > 0) result += ',';
+                    result += leg.ride ? "{\"mode\":\"bus\",\"bus\":" + to_string(leg.bus_id) + ",\"from\":" : "{\"mode\":\"walk\",\"from\":";
+                    append_json_string(result, leg.from);
+                    result += ",\"to\":";
+                    append_json_string(result, leg.to);
+                    result += ",\"depart\":";
+                    append_json_string(result, format_clock_time(leg.departure));
+                    result += ",\"arrive\":";
+                    append_json_string(result, format_clock_time(leg.arrival));
+                    result += '}';
+                }
+                result += ']';
+            }
+        }
+    } else {
+        result += ",\"ok\":false,\"status\":\"unknown_op\"";
+    }
+    out += result + "}\n";
+}
+
+/**
+ * @brief Reads up to BATCH_SIZE lines and parses them as requests.
+ */
+vector<BatchRequest> read_request_batch(istream& in, int& line_number) {
+    TraceSpan span("request", "read_batch");
+    vector<BatchRequest> batch;
+    string line;
+    while (batch.size() < BATCH_SIZE && getline(in, line)) {
+        line_number++;
+        string_view text(line);
+        if (!text.empty() && text.back() == '\r') text.remove_suffix(1);
+        if (text.find_first_not_of(" \t") == string_view::npos) continue;
+
+        BatchRequest request;
+        request.line = line_number;
+        request.valid = request.fields.parse(text);
+        batch.push_back(move(request));
+    }
+    return batch;
+}
+
+size_t BatchProcessor::run(istream& in, ostream& out) {
+    // Pipeline: the next batch is read and parsed on a worker while the current one executes.
+    // Execution itself stays sequential so requests see each other's effects in file order.
+    ThreadPool& pool = shared_thread_pool();
+    int line_number = 0;
+    size_t processed = 0;
+    future<vector<BatchRequest>> next = pool.submit([&in, &line_number]() { return read_request_batch(in, line_number); });
+
+    string results;
+    while (true) {
+        vector<BatchRequest> current = next.get();
+        if (current.empty()) {
+            break;
+        }
+        next = pool.submit([&in, &line_number]() { return read_request_batch(in, line_number); });
+
+        results.clear();
+        for (const BatchRequest& request : current) {
+            execute(request, results);
+        }
+        out.write(results.data(), static_cast<streamsize>(results.size()));
+        processed += current.size();
+    }
+    out.flush();
+    return processed;
+}
+
+#endif // BATCH_H
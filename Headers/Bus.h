@@ -1,14 +1,79 @@
 #ifndef BUS_H
 #define BUS_H
 
+#include <string>
+#include <string_view>
+#include <vector>
+#include <atomic>
+#include <cstdio>
+
 #include "Resource.h"
+#include "Parser.h"
 
 using namespace std;
 
+// Seats per trip day when a bus record does not say otherwise
+const int DEFAULT_BUS_CAPACITY = 60;
+
+/**
+ * @brief Parses a "DD-MM-YYYY" date into a day number (days since 01-01-1970).
+ * Returns false on malformed input or a day that does not exist.
+ */
+bool parse_date(string_view text, int& day) {
+    int d, m, y;
+    if (text.size() != 10 || text[2] != '-' || text[5] != '-' || !parse_int(text.substr(0, 2), d)
+        || !parse_int(text.substr(3, 2), m) || !parse_int(text.substr(6, 4), y) || m < 1 || m > 12 || d < 1) {
+        return false;
+    }
+    static const int month_days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+    if (d > month_days[m - 1] + (m == 2 && leap ? 1 : 0)) {
+        return false;
+    }
+    // Days from civil date (proleptic Gregorian), counting years from March
+    y -= m <= 2;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int year_of_era = y - era * 400;
+    int day_of_year = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    day = era * 146097 + day_of_era - 719468;
+    return true;
+}
+
+// Formats a day number as "DD-MM-YYYY"
+string format_date(int day) {
+    int z = day + 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int day_of_era = z - era * 146097;
+    int year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    int day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    int mp = (5 * day_of_year + 2) / 153;
+    int d = day_of_year - (153 * mp + 2) / 5 + 1;
+    int m = mp < 10 ? mp + 3 : mp - 9;
+    int y = year_of_era + era * 400 + (m <= 2);
+    char text[40];
+    snprintf(text, sizeof(text), "%02d-%02d-%04d", d, m, y);
+    return text;
+}
+
+/**
+ * @brief A bus that runs every day from fromDate to toDate with a fixed number of seats.
+ * Seats taken are counted per day in one small array over that range, updated with atomic
+ * compare-and-swap so concurrent bookings can never oversell a day.
+ */
 class Bus: public Resource{
     private:
         string fromDate;
         string toDate;
+        int capacity = DEFAULT_BUS_CAPACITY;
+
+        // seats_taken[i] counts the seats booked on day first_day + i
+        int first_day = 0;
+        vector<atomic<uint16_t>> seats_taken;
+
+        // Resizes the counters to the fromDate..toDate range (counts are reset)
+        void resetSeatCounters();
+        atomic<uint16_t>* counterFor(int day);
 
     public:
         Bus();
@@ -20,6 +85,24 @@ class Bus: public Resource{
         string getFromDate();
         string getToDate();
 
+        int getCapacity() const { return capacity; }
+        void setCapacity(int seats);
+
+        // Whether the bus runs on the given day number
+        bool runsOn(int day) const { return day >= first_day && day - first_day < static_cast<int>(seats_taken.size()); }
+
+        // Takes one seat on a day; false if the bus does not run then or is full
+        bool reserveSeat(int day);
+        // Gives back a seat taken with reserveSeat
+        bool releaseSeat(int day);
+        // Counts a booking read from file, even if it exceeds today's capacity
+        void restoreSeat(int day);
+
+        int seatsLeft(int day) const;
+
+        // Days in [from_day, to_day] on which the bus runs and still has a seat
+        vector<int> daysWithSeats(int from_day, int to_day) const;
+
         ~Bus();
 };
 
@@ -32,16 +115,85 @@ Bus::Bus(int Id, string Name, string Type, Location loc, bool isAv){
 	type = Type;
 	isAvailable = isAv;
 	location = loc;
+	markDirty();
 }
 
-void Bus::setFromDate(string d) { fromDate = d; }
-void Bus::setToDate(string d) { toDate = d; }
+void Bus::setFromDate(string d) { fromDate = d; resetSeatCounters(); markDirty(); }
+void Bus::setToDate(string d) { toDate = d; resetSeatCounters(); markDirty(); }
 
 string Bus::getFromDate() { return fromDate;}
 string Bus::getToDate() { return toDate; }
 
+void Bus::setCapacity(int seats) {
+    capacity = max(0, min(seats, 65535));
+    markDirty();
+}
+
+void Bus::resetSeatCounters() {
+    int last_day;
+    if (!parse_date(fromDate, first_day) || !parse_date(toDate, last_day) || last_day < first_day) {
+        first_day = 0;
+        seats_taken = vector<atomic<uint16_t>>();
+        return;
+    }
+    seats_taken = vector<atomic<uint16_t>>(static_cast<size_t>(last_day - first_day + 1));
+}
+
+atomic<uint16_t>* Bus::counterFor(int day) {
+    return runsOn(day) ? &seats_taken[static_cast<size_t>(day - first_day)] : nullptr;
+}
+
+bool Bus::reserveSeat(int day) {
+    atomic<uint16_t>* counter = counterFor(day);
+    if (!counter) {
+        return false;
+    }
+    uint16_t taken = counter->load(memory_order_relaxed);
+    do {
+        if (taken >= capacity) return false;
+    } while (!counter->compare_exchange_weak(taken, static_cast<uint16_t>(taken + 1), memory_order_relaxed));
+    return true;
+}
+
+bool Bus::releaseSeat(int day) {
+    atomic<uint16_t>* counter = counterFor(day);
+    if (!counter) {
+        return false;
+    }
+    uint16_t taken = counter->load(memory_order_relaxed);
+    do {
+        if (taken == 0) return false;
+    } while (!counter->compare_exchange_weak(taken, static_cast<uint16_t>(taken - 1), memory_order_relaxed));
+    return true;
+}
+
+void Bus::restoreSeat(int day) {
+    atomic<uint16_t>* counter = counterFor(day);
+    if (counter && counter->load(memory_order_relaxed) < 65535) {
+        counter->fetch_add(1, memory_order_relaxed);
+    }
+}
+
+int Bus::seatsLeft(int day) const {
+    if (!runsOn(day)) {
+        return 0;
+    }
+    return max(0, capacity - static_cast<int>(seats_taken[static_cast<size_t>(day - first_day)].load(memory_order_relaxed)));
+}
+
+vector<int> Bus::daysWithSeats(int from_day, int to_day) const {
+    vector<int> days;
+    int last = first_day + static_cast<int>(seats_taken.size()) - 1;
+    for (int day = max(from_day, first_day); day <= min(to_day, last); ++day) {
+        if (seats_taken[static_cast<size_t>(day - first_day)].load(memory_order_relaxed) < capacity) {
+            days.push_back(day);
+        }
+    }
+    return days;
+}
+
 Bus::~Bus(){
-    
+
 }
 
 
@@ -0,0 +1,671 @@
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <fstream>
+#include <string_view>
+
+#include "MappedFile.h"
+
+using namespace std;
+
+// Infinity value for distances
+const double INF = numeric_limits<double>::infinity();
+const uint32_t NO_NODE = numeric_limits<uint32_t>::max();
+
+/**
+ * @brief A shortest route between two nodes.
+ * segment_weights[i] is the weight of the walk from path[i] to path[i + 1].
+ */
+template <class Node>
+struct BasicRoute {
+    vector<Node> path;
+    vector<double> segment_weights;
+    double distance = INF;
+
+    bool found() const { return distance != INF; }
+};
+
+using NodeRoute = BasicRoute<uint32_t>;
+
+/**
+ * @brief Per-search working memory for Dijkstra on a CSRGraph.
+ * Arrays are sized to the graph once and reused; a generation stamp marks which entries belong
+ * to the current search, so starting a new search does not clear the arrays.
+ * Contains a 4-ary min-heap with decrease-key.
+ */
+class SearchScratch {
+private:
+    vector<double> dist;
+    vector<uint32_t> pred;      // predecessor node
+    vector<uint32_t> pred_arc;  // index of the arc used to reach the node
+    vector<uint32_t> stamp;     // == generation: dist/pred are valid for this search
+    vector<uint32_t> done;      // == generation: node is settled
+    vector<uint32_t> heap_pos;  // position in heap (valid while reached and not settled)
+    vector<pair<double, uint32_t>> heap;
+    uint32_t generation = 0;
+
+    static const size_t ARITY = 4;
+
+    void place(size_t i, const pair<double, uint32_t>& entry) {
+        heap[i] = entry;
+        heap_pos[entry.second] = static_cast<uint32_t>(i);
+    }
+
+    void siftUp(size_t i) {
+        pair<double, uint32_t> entry = heap[i];
+        while (i > 0) {
+            size_t parent = (i - 1) / ARITY;
+            if (heap[parent].first <= entry.first) break;
+            place(i, heap[parent]);
+            i = parent;
+        }
+        place(i, entry);
+    }
+
+    void siftDown(size_t i) {
+        pair<double, uint32_t> entry = heap[i];
+        size_t n = heap.size();
+        while (true) {
+            size_t first = i * ARITY + 1;
+            if (first >= n) break;
+            size_t best = first;
+            size_t last = min(first + ARITY, n);
+            for (size_t c = first + 1; c < last; ++c) {
+                if (heap[c].first < heap[best].first) best = c;
+            }
+            if (heap[best].first >= entry.first) break;
+            place(i, heap[best]);
+            i = best;
+        }
+        place(i, entry);
+    }
+
+public:
+    // Prepares for a new search on a graph with node_count nodes
+    void reset(size_t node_count) {
+        if (dist.size() != node_count) {
+            dist.assign(node_count, INF);
+            pred.assign(node_count, NO_NODE);
+            pred_arc.assign(node_count, NO_NODE);
+            stamp.assign(node_count, 0);
+            done.assign(node_count, 0);
+            heap_pos.assign(node_count, 0);
+            generation = 0;
+        }
+        heap.clear();
+        if (++generation == 0) {
+            // Stamp counter wrapped: clear once and start over
+            fill(stamp.begin(), stamp.end(), 0);
+            fill(done.begin(), done.end(), 0);
+            generation = 1;
+        }
+    }
+
+    bool reached(uint32_t v) const { return stamp[v] == generation; }
+    bool settled(uint32_t v) const { return done[v] == generation; }
+    double distance(uint32_t v) const { return reached(v) ? dist[v] : INF; }
+    uint32_t predecessor(uint32_t v) const { return reached(v) ? pred[v] : NO_NODE; }
+    uint32_t predecessorArc(uint32_t v) const { return reached(v) ? pred_arc[v] : NO_NODE; }
+
+    // Sets v's tentative distance and queues it under `key` (d plus any A* estimate), or lowers
+    // its key if already queued. Returns false if v already has a distance <= d.
+    bool relax(uint32_t v, double d, uint32_t from, uint32_t arc, double key) {
+        if (reached(v)) {
+            if (d >= dist[v] || settled(v)) return false;
+            dist[v] = d;
+            pred[v] = from;
+            pred_arc[v] = arc;
+            heap[heap_pos[v]].first = key;
+            siftUp(heap_pos[v]);
+            return true;
+        }
+        stamp[v] = generation;
+        dist[v] = d;
+        pred[v] = from;
+        pred_arc[v] = arc;
+        heap.push_back({key, v});
+        siftUp(heap.size() - 1);
+        return true;
+    }
+
+    bool relax(uint32_t v, double d, uint32_t from, uint32_t arc) {
+        return relax(v, d, from, arc, d);
+    }
+
+    bool empty() const { return heap.empty(); }
+
+    // Removes and settles the queued node with the smallest distance
+    uint32_t pop() {
+        uint32_t v = heap.front().second;
+        done[v] = generation;
+        pair<double, uint32_t> last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            place(0, last);
+            siftDown(0);
+        }
+        return v;
+    }
+
+    // Smallest key in the heap (the distance itself for plain Dijkstra)
+    double topKey() const { return heap.front().first; }
+};
+
+/**
+ * @brief A directed arc used while building a CSRGraph.
+ */
+struct Arc {
+    uint32_t from;
+    uint32_t to;
+    double weight;
+};
+
+/**
+ * @brief Identifies the text file a compiled graph was made from (size and modification time),
+ * so a stale graph file is never used.
+ */
+struct SourceStamp {
+    uint64_t size = 0;
+    uint64_t modified = 0;
+};
+
+/**
+ * @brief Read-only graph in compressed sparse row form with dense integer node ids.
+ * The arcs leaving node u are targets/weights[offsets[u] .. offsets[u + 1]).
+ *
+ * All arrays, including the names and the name -> id hash index, are flat, so a graph can be
+ * saved as one file and later mapped straight back into memory (see save() and map()) instead
+ * of being rebuilt. Queries read through the same pointers either way.
+ */
+class CSRGraph {
+private:
+    // Storage for graphs built in memory; left empty when the graph is mapped from a file
+    vector<char> name_store;
+    vector<uint32_t> name_offset_store;
+    vector<uint32_t> slot_store;
+    vector<uint32_t> offset_store;
+    vector<uint32_t> target_store;
+    vector<double> weight_store;
+    vector<double> x_store;
+    vector<double> y_store;
+    shared_ptr<MappedFile> mapping;
+
+    // Views into the storage above or into `mapping`
+    size_t node_count = 0;
+    size_t arc_count = 0;
+    size_t slot_count = 0;
+    const char* name_chars = nullptr;        // NUL-terminated names, back to back
+    const uint32_t* name_offsets = nullptr;  // node id -> start of its name in name_chars
+    const uint32_t* name_slots = nullptr;    // open-addressing hash index, name -> node id
+    const uint32_t* offsets = nullptr;
+    const uint32_t* targets = nullptr;
+    double* weights = nullptr;
+
+    // Optional planar node coordinates (metres) for the A* heuristic
+    const double* xs = nullptr;
+    const double* ys = nullptr;
+    double heuristic_speed = 0.0; // metres per minute; 0 = no heuristic
+
+    mutable uint64_t cached_fingerprint = 0;
+    mutable bool fingerprint_known = false;
+
+    static uint64_t hashName(string_view name) {
+        // FNV-1a
+        uint64_t hash = 1469598103934665603ULL;
+        for (char c : name) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    void buildNameIndex();
+
+public:
+    CSRGraph() : offset_store(1, 0) { offsets = offset_store.data(); }
+    CSRGraph(const CSRGraph&) = delete; // views point into the graph's own storage
+    CSRGraph& operator=(const CSRGraph&) = delete;
+
+    // Builds the graph from node names and a list of directed arcs (ids index into node_names)
+    void build(vector<string> node_names, const vector<Arc>& arcs);
+
+    size_t nodeCount() const { return node_count; }
+    size_t arcCount() const { return arc_count; }
+
+    uint32_t idOf(string_view name) const {
+        if (slot_count == 0) {
+            return NO_NODE;
+        }
+        for (size_t slot = hashName(name) & (slot_count - 1); ; slot = (slot + 1) & (slot_count - 1)) {
+            uint32_t id = name_slots[slot];
+            if (id == NO_NODE || nameOf(id) == name) return id;
+        }
+    }
+    string_view nameOf(uint32_t id) const {
+        return string_view(name_chars + name_offsets[id], name_offsets[id + 1] - name_offsets[id] - 1);
+    }
+
+    // Hash of names and arcs, used to check that a cached structure matches this graph
+    uint64_t fingerprint() const;
+
+    /**
+     * @brief Writes the graph as one binary file (arrays, string table and name index) tagged
+     * with the stamp of the text file it came from.
+     */
+    bool save(const string& path, const SourceStamp& source) const;
+
+    /**
+     * @brief Maps a file written by save() into memory; nothing is parsed or rebuilt, so it costs
+     * about the same for any graph size. Fails if the file is damaged or was made from a
+     * different version of the source file.
+     */
+    bool map(const string& path, const SourceStamp& source);
+    bool isMapped() const { return mapping != nullptr; }
+
+    /**
+     * @brief Attaches coordinates to every node (indexed by node id) and derives the A* speed:
+     * the fastest straight-line speed implied by any arc. Straight-line distance / that speed never
+     * overestimates the walking time, so the heuristic is admissible and consistent.
+     */
+    void setCoordinates(vector<double> x, vector<double> y);
+    bool hasCoordinates() const { return heuristic_speed > 0.0; }
+    bool hasPositions() const { return xs != nullptr; }
+    double x(uint32_t id) const { return xs[id]; }
+    double y(uint32_t id) const { return ys[id]; }
+
+    // Lower bound on the walking time from u to t
+    double heuristic(uint32_t u, uint32_t t) const {
+        return hypot(xs[u] - xs[t], ys[u] - ys[t]) / heuristic_speed;
+    }
+
+    // Index of the first arc u -> v, or NO_NODE
+    uint32_t findArc(uint32_t u, uint32_t v) const {
+        for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; ++arc) {
+            if (targets[arc] == v) return arc;
+        }
+        return NO_NODE;
+    }
+
+    /**
+     * @brief Changes an arc's weight in place (INF closes the arc). Node ids stay the same, so
+     * structures keyed by node id remain usable; the A* speed is raised if the arc got faster.
+     */
+    void setArcWeight(uint32_t arc, double weight);
+
+    uint32_t arcBegin(uint32_t u) const { return offsets[u]; }
+    uint32_t arcEnd(uint32_t u) const { return offsets[u + 1]; }
+    uint32_t arcTarget(uint32_t arc) const { return targets[arc]; }
+    double arcWeight(uint32_t arc) const { return weights[arc]; }
+
+    /**
+     * @brief Dijkstra from source, stopping once target is settled (NO_NODE runs to completion).
+     * Results are left in scratch. Returns the number of settled nodes.
+     */
+    size_t search(uint32_t source, uint32_t target, SearchScratch& scratch) const;
+
+    /**
+     * @brief A* from source to target using the coordinate heuristic (plain Dijkstra order when
+     * the graph has no coordinates). Returns the number of settled nodes.
+     */
+    size_t astarSearch(uint32_t source, uint32_t target, SearchScratch& scratch) const;
+
+    /**
+     * @brief Dijkstra from source that reports every node as it is settled, nearest first.
+     * visit(node, distance) returns true to stop the search. Returns the number of settled nodes.
+     */
+    template <class Visit>
+    size_t explore(uint32_t source, SearchScratch& scratch, Visit visit) const;
+
+    // Shortest route between two nodes, with per-segment weights
+    NodeRoute shortestPath(uint32_t source, uint32_t target, SearchScratch& scratch) const;
+    NodeRoute astarPath(uint32_t source, uint32_t target, SearchScratch& scratch) const;
+
+    // Route to target from the search tree currently held in scratch
+    NodeRoute extractRoute(uint32_t source, uint32_t target, const SearchScratch& scratch) const;
+};
+
+void CSRGraph::buildNameIndex() {
+    // Power of two, at least twice the node count, so probes stay short
+    slot_count = 2;
+    while (slot_count < node_count * 2) slot_count *= 2;
+    slot_store.assign(slot_count, NO_NODE);
+    for (uint32_t id = 0; id < node_count; ++id) {
+        size_t slot = hashName(nameOf(id)) & (slot_count - 1);
+        while (slot_store[slot] != NO_NODE) slot = (slot + 1) & (slot_count - 1);
+        slot_store[slot] = id;
+    }
+    name_slots = slot_store.data();
+}
+
+void CSRGraph::build(vector<string> node_names, const vector<Arc>& arcs) {
+    mapping.reset();
+    fingerprint_known = false;
+    node_count = node_names.size();
+    arc_count = arcs.size();
+
+    // String table: names back to back, each followed by a NUL
+    name_store.clear();
+    name_offset_store.assign(1, 0);
+    for (const string& name : node_names) {
+        name_store.insert(name_store.end(), name.begin(), name.end());
+        name_store.push_back('\0');
+        name_offset_store.push_back(static_cast<uint32_t>(name_store.size()));
+    }
+    name_chars = name_store.data();
+    name_offsets = name_offset_store.data();
+    buildNameIndex();
+
+    // Counting sort of the arcs by source node
+    offset_store.assign(node_count + 1, 0);
+    for (const Arc& arc : arcs) {
+        offset_store[arc.from + 1]++;
+    }
+    for (size_t i = 0; i < node_count; ++i) {
+        offset_store[i + 1] += offset_store[i];
+    }
+    target_store.assign(arc_count, 0);
+    weight_store.assign(arc_count, 0.0);
+    vector<uint32_t> next(offset_store.begin(), offset_store.end() - 1);
+    for (const Arc& arc : arcs) {
+        uint32_t slot = next[arc.from]++;
+        target_store[slot] = arc.to;
+        weight_store[slot] = arc.weight;
+    }
+    offsets = offset_store.data();
+    targets = target_store.data();
+    weights = weight_store.data();
+
+    x_store.clear();
+    y_store.clear();
+    xs = ys = nullptr;
+    heuristic_speed = 0.0;
+}
+
+uint64_t CSRGraph::fingerprint() const {
+    if (fingerprint_known) {
+        return cached_fingerprint;
+    }
+    // FNV-1a
+    uint64_t hash = 1469598103934665603ULL;
+    auto mix = [&hash](const void* data, size_t length) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < length; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+        }
+    };
+    mix(name_chars, node_count == 0 ? 0 : name_offsets[node_count]);
+    mix(offsets, (node_count + 1) * sizeof(uint32_t));
+    mix(targets, arc_count * sizeof(uint32_t));
+    mix(weights, arc_count * sizeof(double));
+    cached_fingerprint = hash;
+    fingerprint_known = true;
+    return hash;
+}
+
+const char GRAPH_FILE_MAGIC[8] = {'N', 'U', 'L', 'G', 'R', 'P', 'H', '1'};
+
+// Fixed-size header at the start of a graph file; the arrays follow, each padded to 8 bytes
+struct GraphFileHeader {
+    char magic[8];
+    uint64_t node_count;
+    uint64_t arc_count;
+    uint64_t name_bytes;
+    uint64_t slot_count;
+    uint64_t has_positions;
+    double heuristic_speed;
+    uint64_t fingerprint;
+    SourceStamp source;
+};
+
+bool CSRGraph::save(const string& path, const SourceStamp& source) const {
+    ofstream out(path, ios::binary);
+    if (!out.is_open()) {
+        return false;
+    }
+    GraphFileHeader header;
+    memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(GRAPH_FILE_MAGIC));
+    header.node_count = node_count;
+    header.arc_count = arc_count;
+    header.name_bytes = node_count == 0 ? 0 : name_offsets[node_count];
+    header.slot_count = slot_count;
+    header.has_positions = hasPositions() ? 1 : 0;
+    header.heuristic_speed = heuristic_speed;
+    header.fingerprint = fingerprint();
+    header.source = source;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    const char padding[8] = {};
+    auto section = [&out, &padding](const void* data, size_t bytes) {
+        out.write(static_cast<const char*>(data), static_cast<streamsize>(bytes));
+        out.write(padding, static_cast<streamsize>((8 - bytes % 8) % 8));
+    };
+    section(name_offsets, (node_count + 1) * sizeof(uint32_t));
+    section(name_chars, header.name_bytes);
+    section(name_slots, slot_count * sizeof(uint32_t));
+    section(offsets, (node_count + 1) * sizeof(uint32_t));
+    section(targets, arc_count * sizeof(uint32_t));
+    section(weights, arc_count * sizeof(double));
+    if (hasPositions()) {
+        section(xs, node_count * sizeof(double));
+        section(ys, node_count * sizeof(double));
+    }
+    return static_cast<bool>(out);
+}
+
+bool CSRGraph::map(const string& path, const SourceStamp& source) {
+    auto file = make_shared<MappedFile>();
+    if (!file->open(path) || file->size() < sizeof(GraphFileHeader)) {
+        return false;
+    }
+    GraphFileHeader header;
+    memcpy(&header, file->data(), sizeof(header));
+    if (memcmp(header.magic, GRAPH_FILE_MAGIC, sizeof(GRAPH_FILE_MAGIC)) != 0
+        || header.source.size != source.size || header.source.modified != source.modified
+        || header.node_count >= NO_NODE || header.slot_count <= header.node_count || (header.slot_count & (header.slot_count - 1)) != 0) {
+        return false;
+    }
+
+    // Lay the sections out exactly as save() wrote them, checking that each fits in the file
+    char* cursor = file->data() + sizeof(header);
+    char* end = file->data() + file->size();
+    bool fits = true;
+    auto section = [&cursor, end, &fits](size_t bytes) -> char* {
+        char* start = cursor;
+        size_t padded = bytes + (8 - bytes % 8) % 8;
+        if (static_cast<size_t>(end - cursor) < padded) {
+            fits = false;
+            return nullptr;
+        }
+        cursor += padded;
+        return start;
+    };
+    size_t n = static_cast<size_t>(header.node_count);
+    size_t m = static_cast<size_t>(header.arc_count);
+    const uint32_t* mapped_name_offsets = reinterpret_cast<const uint32_t*>(section((n + 1) * sizeof(uint32_t)));
+    const char* mapped_names = section(static_cast<size_t>(header.name_bytes));
+    const uint32_t* mapped_slots = reinterpret_cast<const uint32_t*>(section(static_cast<size_t>(header.slot_count) * sizeof(uint32_t)));
+    const uint32_t* mapped_offsets = reinterpret_cast<const uint32_t*>(section((n + 1) * sizeof(uint32_t)));
+    const uint32_t* mapped_targets = reinterpret_cast<const uint32_t*>(section(m * sizeof(uint32_t)));
+    double* mapped_weights = reinterpret_cast<double*>(section(m * sizeof(double)));
+    const double* mapped_xs = header.has_positions ? reinterpret_cast<const double*>(section(n * sizeof(double))) : nullptr;
+    const double* mapped_ys = header.has_positions ? reinterpret_cast<const double*>(section(n * sizeof(double))) : nullptr;
+    if (!fits || mapped_offsets[n] != m || mapped_name_offsets[n] != header.name_bytes) {
+        return false;
+    }
+
+    name_store.clear();
+    name_offset_store.clear();
+    slot_store.clear();
+    offset_store.clear();
+    target_store.clear();
+    weight_store.clear();
+    x_store.clear();
+    y_store.clear();
+    mapping = file;
+    node_count = n;
+    arc_count = m;
+    slot_count = static_cast<size_t>(header.slot_count);
+    name_chars = mapped_names;
+    name_offsets = mapped_name_offsets;
+    name_slots = mapped_slots;
+    offsets = mapped_offsets;
+    targets = mapped_targets;
+    weights = mapped_weights;
+    xs = mapped_xs;
+    ys = mapped_ys;
+    heuristic_speed = header.heuristic_speed;
+    cached_fingerprint = header.fingerprint;
+    fingerprint_known = true;
+    return true;
+}
+
+void CSRGraph::setCoordinates(vector<double> x, vector<double> y) {
+    x_store = move(x);
+    y_store = move(y);
+    xs = x_store.data();
+    ys = y_store.data();
+    heuristic_speed = 0.0;
+    for (uint32_t u = 0; u < nodeCount(); ++u) {
+        for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; ++arc) {
+            double straight = hypot(xs[u] - xs[targets[arc]], ys[u] - ys[targets[arc]]);
+            if (weights[arc] <= 0.0) {
+                if (straight > 0.0) { heuristic_speed = 0.0; return; } // zero-time jump: no useful bound
+                continue;
+            }
+            heuristic_speed = max(heuristic_speed, straight / weights[arc]);
+        }
+    }
+    // Small slack so rounding can never make the estimate exceed a real walking time
+    heuristic_speed *= 1.0 + 1e-9;
+}
+
+void CSRGraph::setArcWeight(uint32_t arc, double weight) {
+    weights[arc] = weight;
+    fingerprint_known = false;
+    if (!hasCoordinates() || weight == INF) {
+        return;
+    }
+    uint32_t u = static_cast<uint32_t>(upper_bound(offsets, offsets + node_count + 1, arc) - offsets - 1);
+    double straight = hypot(xs[u] - xs[targets[arc]], ys[u] - ys[targets[arc]]);
+    if (weight <= 0.0) {
+        if (straight > 0.0) heuristic_speed = 0.0; // zero-time jump: no useful bound
+        return;
+    }
+    heuristic_speed = max(heuristic_speed, straight / weight * (1.0 + 1e-9));
+}
+
+size_t CSRGraph::search(uint32_t source, uint32_t target, SearchScratch& scratch) const {
+    scratch.reset(nodeCount());
+    scratch.relax(source, 0.0, NO_NODE, NO_NODE);
+    size_t settled = 0;
+
+    while (!scratch.empty()) {
+        uint32_t u = scratch.pop();
+        double d_u = scratch.distance(u);
+        settled++;
+
+        // Early exit if destination is reached
+        if (u == target) {
+            break;
+        }
+
+        for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; ++arc) {
+            if (weights[arc] != INF) scratch.relax(targets[arc], d_u + weights[arc], u, arc);
+        }
+    }
+    return settled;
+}
+
+size_t CSRGraph::astarSearch(uint32_t source, uint32_t target, SearchScratch& scratch) const {
+    if (!hasCoordinates()) {
+        return search(source, target, scratch);
+    }
+    scratch.reset(nodeCount());
+    scratch.relax(source, 0.0, NO_NODE, NO_NODE, heuristic(source, target));
+    size_t settled = 0;
+
+    while (!scratch.empty()) {
+        uint32_t u = scratch.pop();
+        double d_u = scratch.distance(u);
+        settled++;
+
+        if (u == target) {
+            break;
+        }
+
+        for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; ++arc) {
+            if (weights[arc] == INF) continue;
+            uint32_t v = targets[arc];
+            double d_v = d_u + weights[arc];
+            scratch.relax(v, d_v, u, arc, d_v + heuristic(v, target));
+        }
+    }
+    return settled;
+}
+
+template <class Visit>
+size_t CSRGraph::explore(uint32_t source, SearchScratch& scratch, Visit visit) const {
+    if (source >= nodeCount()) {
+        return 0;
+    }
+    scratch.reset(nodeCount());
+    scratch.relax(source, 0.0, NO_NODE, NO_NODE);
+    size_t settled = 0;
+
+    while (!scratch.empty()) {
+        uint32_t u = scratch.pop();
+        double d_u = scratch.distance(u);
+        settled++;
+        if (visit(u, d_u)) {
+            break;
+        }
+        for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; ++arc) {
+            if (weights[arc] != INF) scratch.relax(targets[arc], d_u + weights[arc], u, arc);
+        }
+    }
+    return settled;
+}
+
+NodeRoute CSRGraph::extractRoute(uint32_t source, uint32_t target, const SearchScratch& scratch) const {
+    NodeRoute route;
+    if (target == NO_NODE || !scratch.reached(target)) {
+        return route;
+    }
+    route.distance = scratch.distance(target);
+
+    // Walk the predecessor arcs back from the target
+    for (uint32_t v = target; v != source; v = scratch.predecessor(v)) {
+        route.path.push_back(v);
+        route.segment_weights.push_back(weights[scratch.predecessorArc(v)]);
+    }
+    route.path.push_back(source);
+    reverse(route.path.begin(), route.path.end());
+    reverse(route.segment_weights.begin(), route.segment_weights.end());
+    return route;
+}
+
+NodeRoute CSRGraph::shortestPath(uint32_t source, uint32_t target, SearchScratch& scratch) const {
+    if (source >= nodeCount() || target >= nodeCount()) {
+        return NodeRoute();
+    }
+    search(source, target, scratch);
+    return extractRoute(source, target, scratch);
+}
+
+NodeRoute CSRGraph::astarPath(uint32_t source, uint32_t target, SearchScratch& scratch) const {
+    if (source >= nodeCount() || target >= nodeCount()) {
+        return NodeRoute();
+    }
+    astarSearch(source, target, scratch);
+    return extractRoute(source, target, scratch);
+}
+
+#endif // CSRGRAPH_H
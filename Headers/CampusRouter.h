@@ -0,0 +1,162 @@
+#ifndef CAMPUSROUTER_H
+#define CAMPUSROUTER_H
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include "Map.h"
+#include "LocationGraph.h"
+
+using namespace std;
+
+/**
+ * @brief Two-level router: buildings from the campus map, rooms from per-building LocationGraphs.
+ *
+ * A room-to-room query is split into three legs: room -> entrance inside the start building,
+ * building -> building on the campus map, entrance -> room inside the destination building.
+ * The building leg comes from the campus map's route cache, so a repeated building pair only
+ * costs the two small local searches. Endpoints may be room names or building names.
+ */
+class CampusRouter {
+private:
+    struct Building {
+        LocationGraph rooms;
+        vector<int> entrances; // room ids that connect to the campus walkways
+    };
+
+    struct RoomRef {
+        string building;
+        int id;
+    };
+
+    const NULMapGraph& campus_map;
+    map<string, Building> buildings;
+    map<string, RoomRef> room_index; // room name -> building and id
+
+    // Cheapest local route between a room and any entrance of its building
+    BasicRoute<int> toEntrance(const Building& building, int room, bool outbound) const;
+
+    void appendLocal(Route& route, const Building& building, const BasicRoute<int>& local, bool skip_first) const;
+
+public:
+    explicit CampusRouter(const NULMapGraph& campus_map) : campus_map(campus_map) {}
+
+    /**
+     * @brief Adds a room (or corridor, stairwell, ...) to a building's internal graph.
+     * Entrances are the points where the building meets the campus map.
+     */
+    void addRoom(const string& building, int id, const string& name, bool entrance = false);
+
+    // Connects two rooms of the same building (walking time in minutes)
+    void addCorridor(const string& building, int from_id, int to_id, double minutes);
+
+    bool isRoom(const string& name) const { return room_index.count(name) > 0; }
+    bool knows(const string& name) const { return isRoom(name) || campus_map.has_node(name); }
+    string buildingOf(const string& name) const;
+
+    // Room names, sorted
+    vector<string> rooms() const;
+
+    // Shortest route between two rooms and/or buildings
+    Route route(const string& from, const string& to) const;
+
+    const NULMapGraph& campusMap() const { return campus_map; }
+};
+
+void CampusRouter::addRoom(const string& building, int id, const string& name, bool entrance) {
+    Building& b = buildings[building];
+    b.rooms.addLocation(id, Location(name));
+    if (entrance) {
+        b.entrances.push_back(id);
+    }
+    room_index[name] = {building, id};
+}
+
+void CampusRouter::addCorridor(const string& building, int from_id, int to_id, double minutes) {
+    buildings[building].rooms.addEdge(from_id, to_id, minutes);
+}
+
+string CampusRouter::buildingOf(const string& name) const {
+    auto it = room_index.find(name);
+    return it == room_index.end() ? name : it->second.building;
+}
+
+vector<string> CampusRouter::rooms() const {
+    vector<string> names;
+    for (const auto& entry : room_index) {
+        names.push_back(entry.first);
+    }
+    return names;
+}
+
+BasicRoute<int> CampusRouter::toEntrance(const Building& building, int room, bool outbound) const {
+    BasicRoute<int> best;
+    for (int entrance : building.entrances) {
+        BasicRoute<int> candidate = outbound ? building.rooms.route(room, entrance) : building.rooms.route(entrance, room);
+        if (candidate.distance < best.distance) {
+            best = move(candidate);
+        }
+    }
+    return best;
+}
+
+void CampusRouter::appendLocal(Route& route, const Building& building, const BasicRoute<int>& local, bool skip_first) const {
+    for (size_t i = skip_first ? 1 : 0; i < local.path.size(); ++i) {
+        route.path.push_back(building.rooms.getLocation(local.path[i])->getName());
+    }
+    route.segment_weights.insert(route.segment_weights.end(), local.segment_weights.begin(), local.segment_weights.end());
+}
+
+Route CampusRouter::route(const string& from, const string& to) const {
+    Route result;
+    if (!knows(from) || !knows(to)) {
+        return result;
+    }
+    auto from_room = room_index.find(from);
+    auto to_room = room_index.find(to);
+    string from_building = buildingOf(from);
+    string to_building = buildingOf(to);
+
+    // Both rooms in one building: a single local search
+    if (from_room != room_index.end() && to_room != room_index.end() && from_building == to_building) {
+        const Building& building = buildings.at(from_building);
+        BasicRoute<int> local = building.rooms.route(from_room->second.id, to_room->second.id);
+        if (local.found()) {
+            appendLocal(result, building, local, false);
+            result.distance = local.distance;
+        }
+        return result;
+    }
+
+    // Leg 1: start room -> entrance (the entrance stands for the building on the campus map)
+    double distance = 0.0;
+    if (from_room != room_index.end()) {
+        const Building& building = buildings.at(from_building);
+        BasicRoute<int> local = toEntrance(building, from_room->second.id, true);
+        if (!local.found()) return result;
+        appendLocal(result, building, local, false);
+        result.path.pop_back();
+        distance += local.distance;
+    }
+
+    // Leg 2: building -> building (cached by the campus map)
+    Route leg = campus_map.shortest_route(from_building, to_building);
+    if (!leg.found()) return Route();
+    result.path.insert(result.path.end(), leg.path.begin(), leg.path.end());
+    result.segment_weights.insert(result.segment_weights.end(), leg.segment_weights.begin(), leg.segment_weights.end());
+    distance += leg.distance;
+
+    // Leg 3: entrance -> destination room
+    if (to_room != room_index.end()) {
+        const Building& building = buildings.at(to_building);
+        BasicRoute<int> local = toEntrance(building, to_room->second.id, false);
+        if (!local.found()) return Route();
+        appendLocal(result, building, local, true);
+        distance += local.distance;
+    }
+    result.distance = distance;
+    return result;
+}
+
+#endif // CAMPUSROUTER_H
@@ -0,0 +1,54 @@
+#ifndef CHANGETRACKER_H
+#define CHANGETRACKER_H
+
+#include <vector>
+#include <mutex>
+
+using namespace std;
+
+/**
+ * @brief Records the ids of records that changed since the last save.
+ * Each record keeps its own dirty flag and only reports its id on the clean -> dirty transition,
+ * so the list stays proportional to the number of changed records.
+ */
+class ChangeTracker {
+private:
+    vector<int> changed_ids;
+    mutex tracker_mutex; // records can be created on loader threads
+
+public:
+    void record(int id) {
+        lock_guard<mutex> lock(tracker_mutex);
+        changed_ids.push_back(id);
+    }
+
+    // Returns the changed ids and resets the list
+    vector<int> take() {
+        lock_guard<mutex> lock(tracker_mutex);
+        vector<int> ids;
+        ids.swap(changed_ids);
+        return ids;
+    }
+
+    void clear() {
+        lock_guard<mutex> lock(tracker_mutex);
+        changed_ids.clear();
+    }
+
+    size_t pending() {
+        lock_guard<mutex> lock(tracker_mutex);
+        return changed_ids.size();
+    }
+};
+
+ChangeTracker& resource_changes() {
+    static ChangeTracker tracker;
+    return tracker;
+}
+
+ChangeTracker& user_changes() {
+    static ChangeTracker tracker;
+    return tracker;
+}
+
+#endif // CHANGETRACKER_H
@@ -0,0 +1,424 @@
+#ifndef CONTRACTIONHIERARCHY_H
+#define CONTRACTIONHIERARCHY_H
+
+#include <vector>
+#include <string>
+#include <queue>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+
+#include "CSRGraph.h"
+#include "ThreadPool.h"
+
+using namespace std;
+
+// Witness searches give up after settling this many nodes; a failed search only costs an extra
+// shortcut. Priority estimates use the smaller limit, real contractions the larger one.
+const size_t CH_ESTIMATE_SETTLE_LIMIT = 50;
+const size_t CH_WITNESS_SETTLE_LIMIT = 500;
+
+/**
+ * @brief An arc of the hierarchy: either an arc of the original graph or a shortcut that stands
+ * for the two arcs first -> via -> second (child_first, child_second are edge ids).
+ */
+struct CHEdge {
+    uint32_t from;
+    uint32_t to;
+    double weight;
+    uint32_t child_first;  // NO_NODE for original arcs
+    uint32_t child_second;
+
+    bool isShortcut() const { return child_first != NO_NODE; }
+};
+
+/**
+ * @brief Working memory for one hierarchy query: one search per direction.
+ */
+struct HierarchyScratch {
+    SearchScratch forward;
+    SearchScratch backward;
+};
+
+/**
+ * @brief Contraction hierarchy over a CSRGraph.
+ *
+ * Preprocessing contracts the nodes one by one in order of importance (edge difference plus
+ * contracted neighbours); whenever removing a node would lengthen a shortest route between two
+ * remaining neighbours, a shortcut arc is added. A query then runs a bidirectional Dijkstra that
+ * only climbs to more important nodes, which settles a few hundred nodes even on large maps.
+ * Routes are unpacked back to original arcs by expanding shortcuts.
+ */
+class ContractionHierarchy {
+private:
+    size_t n = 0;
+    uint64_t graph_fingerprint = 0;
+    vector<uint32_t> rank;   // contraction order: higher = more important
+    vector<CHEdge> edges;    // original arcs and shortcuts
+
+    // Upward search graph: up_edges[up_offsets[u] .. up_offsets[u + 1]) are edge ids leaving u
+    // towards more important nodes; down_edges the same for edges entering u from above.
+    vector<uint32_t> up_offsets;
+    vector<uint32_t> up_edges;
+    vector<uint32_t> down_offsets;
+    vector<uint32_t> down_edges;
+
+    // Adjacency of the not yet contracted part of the graph, used only while building
+    struct BuildState {
+        vector<vector<uint32_t>> out;
+        vector<vector<uint32_t>> in;
+        vector<uint32_t> contracted_neighbours;
+    };
+
+    void addEdge(BuildState& state, uint32_t from, uint32_t to, double weight, uint32_t first, uint32_t second);
+    size_t contractNode(BuildState& state, uint32_t v, SearchScratch& scratch, bool simulate);
+    int priority(BuildState& state, uint32_t v, SearchScratch& scratch);
+    void buildSearchGraph();
+    bool stalled(const SearchScratch& search, uint32_t u, bool forward) const;
+    void unpack(uint32_t edge, NodeRoute& route) const;
+
+public:
+    void build(const CSRGraph& graph);
+
+    // Binary cache; load() fails if the file was built for a different graph
+    bool save(const string& path) const;
+    bool load(const string& path, const CSRGraph& graph);
+
+    bool builtFor(const CSRGraph& graph) const { return n == graph.nodeCount() && graph_fingerprint == graph.fingerprint(); }
+    size_t nodeCount() const { return n; }
+    size_t edgeCount() const { return edges.size(); }
+    size_t shortcutCount() const;
+    size_t memoryBytes() const {
+        return rank.size() * sizeof(uint32_t) + edges.size() * sizeof(CHEdge)
+             + (up_offsets.size() + up_edges.size() + down_offsets.size() + down_edges.size()) * sizeof(uint32_t);
+    }
+
+    /**
+     * @brief Bidirectional upward search. Returns the shortest distance (INF if unreachable) and
+     * leaves both search trees in scratch; meeting_node receives the node where they join.
+     */
+    double search(uint32_t source, uint32_t target, HierarchyScratch& scratch, uint32_t& meeting_node) const;
+
+    // Shortest route with per-segment weights, expressed in original arcs
+    NodeRoute route(uint32_t source, uint32_t target, HierarchyScratch& scratch) const;
+};
+
+void ContractionHierarchy::addEdge(BuildState& state, uint32_t from, uint32_t to, double weight,
+                                   uint32_t first, uint32_t second) {
+    // Keep at most one arc per (from, to) among the remaining nodes
+    for (uint32_t e : state.out[from]) {
+        if (edges[e].to == to) {
+            if (weight < edges[e].weight) {
+                edges[e].weight = weight;
+                edges[e].child_first = first;
+                edges[e].child_second = second;
+            }
+            return;
+        }
+    }
+    uint32_t id = static_cast<uint32_t>(edges.size());
+    edges.push_back({from, to, weight, first, second});
+    state.out[from].push_back(id);
+    state.in[to].push_back(id);
+}
+
+size_t ContractionHierarchy::contractNode(BuildState& state, uint32_t v, SearchScratch& scratch, bool simulate) {
+    double max_out = 0.0;
+    for (uint32_t e : state.out[v]) {
+        max_out = max(max_out, edges[e].weight);
+    }
+
+    size_t shortcuts = 0;
+    // Copies: adding shortcuts below may reallocate the adjacency lists of v's neighbours
+    vector<uint32_t> in_edges = state.in[v];
+    vector<uint32_t> out_edges = state.out[v];
+    for (uint32_t e_in : in_edges) {
+        uint32_t u = edges[e_in].from;
+        double limit = edges[e_in].weight + max_out;
+
+        // Witness search from u that avoids v, bounded by the longest route through v
+        scratch.reset(n);
+        scratch.relax(u, 0.0, NO_NODE, NO_NODE);
+        size_t settled = 0;
+        size_t settle_limit = simulate ? CH_ESTIMATE_SETTLE_LIMIT : CH_WITNESS_SETTLE_LIMIT;
+        size_t targets_left = out_edges.size();
+        while (!scratch.empty() && scratch.topKey() <= limit && settled < settle_limit && targets_left > 0) {
+            uint32_t x = scratch.pop();
+            double d_x = scratch.distance(x);
+            settled++;
+            for (uint32_t e_out : out_edges) {
+                if (edges[e_out].to == x) targets_left--;
+            }
+            for (uint32_t e : state.out[x]) {
+                if (edges[e].to != v) {
+                    scratch.relax(edges[e].to, d_x + edges[e].weight, x, e);
+                }
+            }
+        }
+
+        for (uint32_t e_out : out_edges) {
+            uint32_t w = edges[e_out].to;
+            if (w == u) continue;
+            double via_v = edges[e_in].weight + edges[e_out].weight;
+            if (scratch.distance(w) <= via_v) continue; // witness route found
+            shortcuts++;
+            if (!simulate) {
+                addEdge(state, u, w, via_v, e_in, e_out);
+            }
+        }
+    }
+
+    if (!simulate) {
+        // Detach v from the remaining graph
+        for (uint32_t e : in_edges) {
+            vector<uint32_t>& list = state.out[edges[e].from];
+            list.erase(find(list.begin(), list.end(), e));
+            state.contracted_neighbours[edges[e].from]++;
+        }
+        for (uint32_t e : out_edges) {
+            vector<uint32_t>& list = state.in[edges[e].to];
+            list.erase(find(list.begin(), list.end(), e));
+            state.contracted_neighbours[edges[e].to]++;
+        }
+        state.in[v].clear();
+        state.out[v].clear();
+    }
+    return shortcuts;
+}
+
+int ContractionHierarchy::priority(BuildState& state, uint32_t v, SearchScratch& scratch) {
+    int shortcuts = static_cast<int>(contractNode(state, v, scratch, true));
+    int removed = static_cast<int>(state.in[v].size() + state.out[v].size());
+    return 2 * (shortcuts - removed) + static_cast<int>(state.contracted_neighbours[v]);
+}
+
+void ContractionHierarchy::build(const CSRGraph& graph) {
+    n = graph.nodeCount();
+    graph_fingerprint = graph.fingerprint();
+    edges.clear();
+
+    BuildState state;
+    state.out.assign(n, {});
+    state.in.assign(n, {});
+    state.contracted_neighbours.assign(n, 0);
+    for (uint32_t u = 0; u < n; ++u) {
+        for (uint32_t arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+            if (graph.arcTarget(arc) != u) {
+                addEdge(state, u, graph.arcTarget(arc), graph.arcWeight(arc), NO_NODE, NO_NODE);
+            }
+        }
+    }
+
+    // Initial priorities only read the graph, so they are computed in parallel
+    vector<int> initial(n);
+    parallel_for(shared_thread_pool(), n, [this, &state, &initial](size_t begin, size_t end) {
+        SearchScratch scratch;
+        for (size_t v = begin; v < end; ++v) {
+            initial[v] = priority(state, static_cast<uint32_t>(v), scratch);
+        }
+    }, 256);
+
+    using Entry = pair<int, uint32_t>;
+    priority_queue<Entry, vector<Entry>, greater<Entry>> queue;
+    for (uint32_t v = 0; v < n; ++v) {
+        queue.push({initial[v], v});
+    }
+
+    // Lazy updates: a popped node is re-evaluated and put back if it is no longer the cheapest
+    SearchScratch scratch;
+    rank.assign(n, 0);
+    uint32_t next_rank = 0;
+    while (!queue.empty()) {
+        uint32_t v = queue.top().second;
+        queue.pop();
+        int current = priority(state, v, scratch);
+        if (!queue.empty() && current > queue.top().first) {
+            queue.push({current, v});
+            continue;
+        }
+        contractNode(state, v, scratch, false);
+        rank[v] = next_rank++;
+    }
+    buildSearchGraph();
+}
+
+void ContractionHierarchy::buildSearchGraph() {
+    up_offsets.assign(n + 1, 0);
+    down_offsets.assign(n + 1, 0);
+    for (const CHEdge& edge : edges) {
+        if (rank[edge.from] < rank[edge.to]) {
+            up_offsets[edge.from + 1]++;
+        } else {
+            down_offsets[edge.to + 1]++;
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        up_offsets[i + 1] += up_offsets[i];
+        down_offsets[i + 1] += down_offsets[i];
+    }
+    up_edges.assign(up_offsets[n], 0);
+    down_edges.assign(down_offsets[n], 0);
+    vector<uint32_t> next_up(up_offsets.begin(), up_offsets.end() - 1);
+    vector<uint32_t> next_down(down_offsets.begin(), down_offsets.end() - 1);
+    for (uint32_t e = 0; e < edges.size(); ++e) {
+        if (rank[edges[e].from] < rank[edges[e].to]) {
+            up_edges[next_up[edges[e].from]++] = e;
+        } else {
+            down_edges[next_down[edges[e].to]++] = e;
+        }
+    }
+}
+
+size_t ContractionHierarchy::shortcutCount() const {
+    size_t count = 0;
+    for (const CHEdge& edge : edges) {
+        if (edge.isShortcut()) count++;
+    }
+    return count;
+}
+
+bool ContractionHierarchy::stalled(const SearchScratch& search, uint32_t u, bool forward) const {
+    // Stall-on-demand: u's distance is not final if a more important node reaches it more cheaply
+    const vector<uint32_t>& offsets = forward ? down_offsets : up_offsets;
+    const vector<uint32_t>& list = forward ? down_edges : up_edges;
+    double d_u = search.distance(u);
+    for (uint32_t i = offsets[u]; i < offsets[u + 1]; ++i) {
+        const CHEdge& edge = edges[list[i]];
+        uint32_t x = forward ? edge.from : edge.to;
+        if (search.distance(x) + edge.weight < d_u) {
+            return true;
+        }
+    }
+    return false;
+}
+
+double ContractionHierarchy::search(uint32_t source, uint32_t target, HierarchyScratch& scratch, uint32_t& meeting_node) const {
+    SearchScratch& fw = scratch.forward;
+    SearchScratch& bw = scratch.backward;
+    fw.reset(n);
+    bw.reset(n);
+    fw.relax(source, 0.0, NO_NODE, NO_NODE);
+    bw.relax(target, 0.0, NO_NODE, NO_NODE);
+
+    double best = INF;
+    meeting_node = NO_NODE;
+    while (true) {
+        bool fw_live = !fw.empty() && fw.topKey() < best;
+        bool bw_live = !bw.empty() && bw.topKey() < best;
+        if (!fw_live && !bw_live) {
+            break;
+        }
+        // Advance the side with the smaller key
+        bool forward = fw_live && (!bw_live || fw.topKey() <= bw.topKey());
+        SearchScratch& self = forward ? fw : bw;
+        const SearchScratch& other = forward ? bw : fw;
+
+        uint32_t u = self.pop();
+        double d_u = self.distance(u);
+        if (other.reached(u) && d_u + other.distance(u) < best) {
+            best = d_u + other.distance(u);
+            meeting_node = u;
+        }
+        if (stalled(self, u, forward)) {
+            continue;
+        }
+
+        // Forward climbs along edges leaving u, backward along edges entering u
+        const vector<uint32_t>& offsets = forward ? up_offsets : down_offsets;
+        const vector<uint32_t>& list = forward ? up_edges : down_edges;
+        for (uint32_t i = offsets[u]; i < offsets[u + 1]; ++i) {
+            const CHEdge& edge = edges[list[i]];
+            self.relax(forward ? edge.to : edge.from, d_u + edge.weight, u, list[i]);
+        }
+    }
+    return best;
+}
+
+void ContractionHierarchy::unpack(uint32_t edge, NodeRoute& route) const {
+    // Depth-first expansion without recursion; first child is expanded first
+    vector<uint32_t> stack(1, edge);
+    while (!stack.empty()) {
+        const CHEdge& current = edges[stack.back()];
+        stack.pop_back();
+        if (current.isShortcut()) {
+            stack.push_back(current.child_second);
+            stack.push_back(current.child_first);
+        } else {
+            route.path.push_back(current.to);
+            route.segment_weights.push_back(current.weight);
+        }
+    }
+}
+
+NodeRoute ContractionHierarchy::route(uint32_t source, uint32_t target, HierarchyScratch& scratch) const {
+    NodeRoute result;
+    if (source >= n || target >= n) {
+        return result;
+    }
+    uint32_t meet;
+    double distance = search(source, target, scratch, meet);
+    if (distance == INF) {
+        return result;
+    }
+    result.distance = distance;
+    result.path.push_back(source);
+
+    // Forward tree: source -> meet (collected backwards), then backward tree: meet -> target
+    vector<uint32_t> up_path;
+    for (uint32_t v = meet; v != source; v = scratch.forward.predecessor(v)) {
+        up_path.push_back(scratch.forward.predecessorArc(v));
+    }
+    for (auto it = up_path.rbegin(); it != up_path.rend(); ++it) {
+        unpack(*it, result);
+    }
+    for (uint32_t v = meet; v != target; v = scratch.backward.predecessor(v)) {
+        unpack(scratch.backward.predecessorArc(v), result);
+    }
+    return result;
+}
+
+const char HIERARCHY_MAGIC[8] = {'N', 'U', 'L', 'C', 'H', 'R', 'C', '1'};
+
+bool ContractionHierarchy::save(const string& path) const {
+    ofstream out(path, ios::binary);
+    if (!out.is_open()) {
+        return false;
+    }
+    uint64_t header[3] = {static_cast<uint64_t>(n), static_cast<uint64_t>(edges.size()), graph_fingerprint};
+    out.write(HIERARCHY_MAGIC, sizeof(HIERARCHY_MAGIC));
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(rank.data()), static_cast<streamsize>(rank.size() * sizeof(uint32_t)));
+    out.write(reinterpret_cast<const char*>(edges.data()), static_cast<streamsize>(edges.size() * sizeof(CHEdge)));
+    return static_cast<bool>(out);
+}
+
+bool ContractionHierarchy::load(const string& path, const CSRGraph& graph) {
+    ifstream in(path, ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    char magic[sizeof(HIERARCHY_MAGIC)];
+    uint64_t header[3];
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!in || memcmp(magic, HIERARCHY_MAGIC, sizeof(magic)) != 0
+        || header[0] != graph.nodeCount() || header[2] != graph.fingerprint()) {
+        return false;
+    }
+
+    vector<uint32_t> loaded_rank(static_cast<size_t>(header[0]));
+    vector<CHEdge> loaded_edges(static_cast<size_t>(header[1]));
+    in.read(reinterpret_cast<char*>(loaded_rank.data()), static_cast<streamsize>(loaded_rank.size() * sizeof(uint32_t)));
+    in.read(reinterpret_cast<char*>(loaded_edges.data()), static_cast<streamsize>(loaded_edges.size() * sizeof(CHEdge)));
+    if (!in) {
+        return false;
+    }
+    n = static_cast<size_t>(header[0]);
+    graph_fingerprint = header[2];
+    rank.swap(loaded_rank);
+    edges.swap(loaded_edges);
+    buildSearchGraph();
+    return true;
+}
+
+#endif // CONTRACTIONHIERARCHY_H
@@ -0,0 +1,112 @@
+#ifndef DISTANCEMATRIX_H
+#define DISTANCEMATRIX_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iomanip>
+
+#include "CSRGraph.h"
+#include "ThreadPool.h"
+
+using namespace std;
+
+/**
+ * @brief Dense matrix of walking times, row = origin, column = destination.
+ * Unreachable (or unknown) pairs hold INF.
+ */
+class DistanceMatrix {
+private:
+    vector<string> origins;
+    vector<string> destinations;
+    vector<double> values; // origins.size() x destinations.size(), row-major
+
+public:
+    DistanceMatrix() = default;
+    DistanceMatrix(vector<string> origin_names, vector<string> destination_names)
+        : origins(move(origin_names)), destinations(move(destination_names)),
+          values(origins.size() * destinations.size(), INF) {}
+
+    size_t rows() const { return origins.size(); }
+    size_t cols() const { return destinations.size(); }
+    const string& origin(size_t row) const { return origins[row]; }
+    const string& destination(size_t col) const { return destinations[col]; }
+
+    double at(size_t row, size_t col) const { return values[row * destinations.size() + col]; }
+    double* row(size_t r) { return &values[r * destinations.size()]; }
+
+    // CSV with a header row of destinations and one row per origin; unreachable cells are empty
+    void writeCsv(ostream& out) const;
+    bool saveCsv(const string& path) const;
+};
+
+void DistanceMatrix::writeCsv(ostream& out) const {
+    // Names are quoted since building names may contain commas
+    auto quoted = [&out](const string& text) {
+        out << '"';
+        for (char c : text) {
+            if (c == '"') out << '"';
+            out << c;
+        }
+        out << '"';
+    };
+    out << "from";
+    for (const string& name : destinations) {
+        out << ',';
+        quoted(name);
+    }
+    out << '\n' << fixed << setprecision(2);
+    for (size_t r = 0; r < origins.size(); ++r) {
+        quoted(origins[r]);
+        for (size_t c = 0; c < destinations.size(); ++c) {
+            out << ',';
+            if (at(r, c) != INF) out << at(r, c);
+        }
+        out << '\n';
+    }
+}
+
+bool DistanceMatrix::saveCsv(const string& path) const {
+    ofstream out(path);
+    if (!out.is_open()) {
+        return false;
+    }
+    writeCsv(out);
+    return static_cast<bool>(out);
+}
+
+/**
+ * @brief Fills matrix with the walking times from each source to each target (node ids; NO_NODE
+ * leaves the row or column at INF).
+ * Every row is one Dijkstra that stops once all targets are settled. Rows run in parallel on the
+ * shared thread pool; the graph and target set are shared read-only and each worker thread reuses
+ * its own scratch, so no memory is allocated per row.
+ */
+void fill_distance_matrix(const CSRGraph& graph, const vector<uint32_t>& sources, const vector<uint32_t>& targets,
+                          DistanceMatrix& matrix) {
+    vector<char> is_target(graph.nodeCount(), 0);
+    size_t distinct_targets = 0;
+    for (uint32_t t : targets) {
+        if (t != NO_NODE && !is_target[t]) {
+            is_target[t] = 1;
+            distinct_targets++;
+        }
+    }
+
+    parallel_for(shared_thread_pool(), sources.size(), [&](size_t begin, size_t end) {
+        thread_local SearchScratch scratch;
+        for (size_t r = begin; r < end; ++r) {
+            if (sources[r] == NO_NODE) continue;
+            size_t remaining = distinct_targets;
+            graph.explore(sources[r], scratch, [&](uint32_t u, double) {
+                return is_target[u] && --remaining == 0;
+            });
+            double* row = matrix.row(r);
+            for (size_t c = 0; c < targets.size(); ++c) {
+                row[c] = targets[c] == NO_NODE ? INF : scratch.distance(targets[c]);
+            }
+        }
+    });
+}
+
+#endif // DISTANCEMATRIX_H
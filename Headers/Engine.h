@@ -0,0 +1,148 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <string>
+#include <map>
+
+#include "Hashtable.h"
+#include "User.h"
+#include "Resource.h"
+#include "Lab.h"
+#include "Bus.h"
+
+using namespace std;
+
+extern int next_user_id;
+
+/**
+ * @brief Outcome of an engine operation. The interactive menu and the batch processor both
+ * call the functions below and decide for themselves how to present the result.
+ */
+enum class EngineStatus {
+    Ok,
+    AlreadyExists,      // sign up with a taken username
+    InvalidCredentials, // login failed
+    ResourceNotFound,
+    SlotUnavailable,    // slot already booked or slot ID invalid
+    NotBooked,          // cancel of a slot that is not booked
+    NotSupported,       // operation not supported for this resource type
+    InvalidDate,        // bus booking for a day the bus does not run
+    NoSeats             // bus is fully booked on that day
+};
+
+const char* status_name(EngineStatus status) {
+    switch (status) {
+        case EngineStatus::Ok: return "ok";
+        case EngineStatus::AlreadyExists: return "already_exists";
+        case EngineStatus::InvalidCredentials: return "invalid_credentials";
+        case EngineStatus::ResourceNotFound: return "resource_not_found";
+        case EngineStatus::SlotUnavailable: return "slot_unavailable";
+        case EngineStatus::NotBooked: return "not_booked";
+        case EngineStatus::NotSupported: return "not_supported";
+        case EngineStatus::InvalidDate: return "invalid_date";
+        case EngineStatus::NoSeats: return "no_seats";
+    }
+    return "unknown";
+}
+
+bool is_slotted(const Resource* resource) {
+    return resource->getType() == "LAB" || resource->getType() == "LECTUREHALL";
+}
+
+/**
+ * @brief Creates a new account with the next free user ID.
+ */
+EngineStatus signup_user(HashTable& user_db, const string& name, const string& password, const string& type = "Regular") {
+    if (user_db.get(name) != nullptr) {
+        return EngineStatus::AlreadyExists;
+    }
+    user_db.insert(next_user_id++, name, password, type);
+    return EngineStatus::Ok;
+}
+
+/**
+ * @brief Books a resource for a user. Slotted resources (labs, lecture halls) need a slot ID;
+ * buses need the travel day (a day number, see parse_date) and take one seat on it.
+ */
+EngineStatus book_resource(map<int, Resource*>& resources, User* user, int rid, int sid = -1) {
+    auto it = resources.find(rid);
+    if (it == resources.end()) {
+        return EngineStatus::ResourceNotFound;
+    }
+    Resource* resource = it->second;
+
+    if (is_slotted(resource)) {
+        Lab* lab = dynamic_cast<Lab*>(resource);
+        if (!lab->bookSlot(sid)) {
+            return EngineStatus::SlotUnavailable;
+        }
+        user->addBooking(lab, sid);
+        return EngineStatus::Ok;
+    }
+    if (Bus* bus = dynamic_cast<Bus*>(resource)) {
+        if (!bus->runsOn(sid)) {
+            return EngineStatus::InvalidDate;
+        }
+        if (!bus->reserveSeat(sid)) {
+            return EngineStatus::NoSeats;
+        }
+        user->addBooking(bus, sid);
+        return EngineStatus::Ok;
+    }
+    return EngineStatus::NotSupported;
+}
+
+/**
+ * @brief Cancels a user's booking. Only a booking the user holds can be cancelled: for slotted
+ * resources that slot's booking is removed from the user, then the slot is freed, which also
+ * hands it to the next user on the waitlist. A bus booking with a travel day gives its seat back.
+ */
+EngineStatus cancel_booking(map<int, Resource*>& resources, User* user, int rid, int sid = -1) {
+    auto it = resources.find(rid);
+    if (it == resources.end()) {
+        return EngineStatus::ResourceNotFound;
+    }
+    Resource* resource = it->second;
+
+    if (is_slotted(resource)) {
+        Lab* lab = dynamic_cast<Lab*>(resource);
+        if (sid < 0 || !user->removeBooking(rid, sid)) {
+            return EngineStatus::NotBooked;
+        }
+        lab->cancelSlotBooking(sid);
+        return EngineStatus::Ok;
+    } else if (Bus* bus = dynamic_cast<Bus*>(resource)) {
+        if (sid >= 0) {
+            if (!user->removeBooking(rid, sid)) {
+                return EngineStatus::NotBooked;
+            }
+            bus->releaseSeat(sid);
+            return EngineStatus::Ok;
+        }
+        // No day given: every booking of this bus goes, with its seat
+        for (const Booking& booking : user->getBookings()) {
+            if (booking.first == bus && booking.second >= 0) {
+                bus->releaseSeat(booking.second);
+            }
+        }
+    }
+    user->removeBooking(rid);
+    return EngineStatus::Ok;
+}
+
+/**
+ * @brief Adds a user to a resource's waitlist (labs and lecture halls only).
+ */
+EngineStatus join_waitlist(map<int, Resource*>& resources, User* user, int rid) {
+    auto it = resources.find(rid);
+    if (it == resources.end()) {
+        return EngineStatus::ResourceNotFound;
+    }
+    if (!is_slotted(it->second)) {
+        return EngineStatus::NotSupported;
+    }
+    user->addToResourceWaitlist(it->second);
+    return EngineStatus::Ok;
+}
+
+#endif // ENGINE_H
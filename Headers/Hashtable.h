@@ -4,10 +4,16 @@
 #include <iostream>
 #include <vector>
 #include <list>
+#include <map>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <functional> // Required for std::hash
 #include <algorithm>  // Required for std::remove_if
 #include "User.h"
+#include "StringArena.h"
+#include "Log.h"
+#include "Metrics.h"
 
 using namespace std;
 
@@ -16,9 +22,19 @@ private:
     // Use a vector of lists to hold User objects (Chaining)
     vector<list<User>> table;
     int size;
+    int user_count = 0;
+    // The users' names and password hashes. Freed with the table (and its copies), so a reload
+    // that replaces the table releases the old text.
+    shared_ptr<StringArena> text_arena = make_shared<StringArena>();
+    // User ID -> name (the hash key, viewing the user's own copy), ordered so a range of IDs can be walked
+    map<int, string_view> id_index;
 
     // A utility to compute the index from the key (username)
-    int _hash(const string&) const;
+    int _hash(string_view) const;
+
+    // Moves every user into a table of the given number of buckets. Nodes are spliced, not
+    // copied, so pointers to users stay valid.
+    void rehash(int buckets);
 
 public:
     // Constructor
@@ -26,13 +42,28 @@ public:
 
     // 2. The sign-up function: Accepts user data and stores the User object
     // Note: Type parameter is optional here to match the User ADT constructor
-    void insert(int, const string&, const string&, string);
+    // Returns the new user, or the existing one if the name is taken. An ID that already belongs
+    // to another user is replaced by the next free one, with a warning. The table doubles its
+    // buckets once it holds more users than buckets.
+    User* insert(int, const string&, const string&, string);
+
+    // Grows the table to at least one bucket per user for the given number of users
+    void reserve(int users);
         
     // 3. Retrieves a pointer to the User object based on the name (key)
-    User* get(const string&);
+    User* get(string_view);
+
+    // Retrieves a user by ID (nullptr if not found)
+    User* getById(int id);
+
+    // IDs in [first_id, last_id) that belong to existing users, in ascending order
+    vector<int> idsInRange(int first_id, int last_id) const;
+
+    // Marks every stored user as saved
+    void clearDirtyFlags();
 
     // Authenticate a user by username and password. Returns pointer to User on success, nullptr otherwise.
-    User* login(const string& username, const string& password);
+    User* login(string_view username, string_view password);
 
     // Display the hash table structure
     void display() const;
@@ -41,6 +72,16 @@ public:
         return size;
     }
 
+    int getUserCount() const {
+        return user_count;
+    }
+
+    // Where the users' text is kept, for User::setName and setPasswordHash
+    StringArena& textArena() {
+        return *text_arena;
+    }
+
+    // The users' text stays in this table's arena, so the copy is only valid while the table is
     vector<list<User>> getAllUsers() const{
         return table;
     }
@@ -48,39 +89,75 @@ public:
 
 
 // A utility to compute the index from the key (username)
-int HashTable::_hash(const string& key) const {
-    hash<string> hash_fn;
+int HashTable::_hash(string_view key) const {
+    hash<string_view> hash_fn;
     return hash_fn(key) % size;
 }
 
 // Constructor
-HashTable::HashTable(int table_size) : size(table_size) {
+HashTable::HashTable(int table_size) : size(max(1, table_size)) {
     table.resize(size);
 }
 
+void HashTable::rehash(int buckets) {
+    vector<list<User>> old = move(table);
+    size = buckets;
+    table = vector<list<User>>(size);
+    for (list<User>& bucket : old) {
+        while (!bucket.empty()) {
+            list<User>& target = table[_hash(bucket.front().getName())];
+            target.splice(target.end(), bucket, bucket.begin());
+        }
+    }
+}
+
+void HashTable::reserve(int users) {
+    if (users > size) {
+        rehash(users);
+    }
+}
+
 // 2. The sign-up function: Accepts user data and stores the User object
 // Note: Type parameter is optional here to match the User ADT constructor
-void HashTable::insert(int id, const string& name, const string& passwordHash, const string type) {
+User* HashTable::insert(int id, const string& name, const string& passwordHash, const string type) {
     // Use 'name' as the key for hashing
     int index = _hash(name);
-    list<User>& bucket = table[index];
 
     // 2. Check for existing user (collision/update handling)
-    for (User& user : bucket) {
+    for (User& user : table[index]) {
         if (user.getName() == name) {
             // Key found: User already exists, update password hash
-            cout << "User '" << name << "' already exists!" << endl;
-            return;
+            engine_log.info("users", "User '", name, "' already exists!");
+            return &user;
         }
     }
 
+    // Every ID names one user: the index (and the segment saves that walk it) must not lose one
+    auto taken = id_index.find(id);
+    if (taken != id_index.end()) {
+        int free_id = id_index.rbegin()->first + 1;
+        engine_log.warn("users", "User ID ", id, " of '", name, "' already belongs to '", taken->second,
+                        "'; stored as ID ", free_id, ".");
+        id = free_id;
+    }
+
+    // Keep chains short as the table fills
+    if (user_count >= size) {
+        rehash(size * 2);
+        index = _hash(name);
+    }
+
     // 3. Key is new: Add the new User object to the bucket (sign up)
-    bucket.emplace_back(id, name, passwordHash, type);
-    cout << "✅ Success! Signed up user: '" << name << "' (Stored in Bucket " << index << ")" << endl;
+    list<User>& bucket = table[index];
+    bucket.emplace_back(id, name, passwordHash, type, *text_arena);
+    user_count++;
+    id_index[id] = bucket.back().getName();
+    engine_log.debug("users", "Signed up user: '", name, "' (Stored in Bucket ", index, ")");
+    return &bucket.back();
 }
 
 // 3. Retrieves a pointer to the User object based on the name (key)
-User* HashTable::get(const string& name) {
+User* HashTable::get(string_view name) {
     int index = _hash(name);
     list<User>& bucket = table[index];
 
@@ -94,18 +171,46 @@ User* HashTable::get(const string& name) {
     return nullptr; // Key not found
 }
 
+User* HashTable::getById(int id) {
+    auto it = id_index.find(id);
+    if (it == id_index.end()) {
+        return nullptr;
+    }
+    User* user = get(it->second);
+    return (user && user->getId() == id) ? user : nullptr;
+}
+
+vector<int> HashTable::idsInRange(int first_id, int last_id) const {
+    vector<int> ids;
+    for (auto it = id_index.lower_bound(first_id); it != id_index.end() && it->first < last_id; ++it) {
+        ids.push_back(it->first);
+    }
+    return ids;
+}
+
+void HashTable::clearDirtyFlags() {
+    for (list<User>& bucket : table) {
+        for (User& user : bucket) {
+            user.clearDirty();
+        }
+    }
+}
+
 // Authenticate user by username and password (simple plaintext compare for demo)
-User* HashTable::login(const string& username, const string& password) {
+User* HashTable::login(string_view username, string_view password) {
+    MetricTimer timer(Metric::Login);
     int index = _hash(username);
     list<User>& bucket = table[index];
     for (User& user : bucket) {
         if (user.getName() == username) {
-            if (user.getPasswordHash() == password && user.getType().size() >= 0) {
+            if (user.getPasswordHash() == password) {
                 return &user;
             }
+            timer.fail();
             return nullptr;
         }
     }
+    timer.fail();
     return nullptr;
 }
 
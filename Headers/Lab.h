@@ -6,8 +6,16 @@
 #include <vector>
 #include <queue> 
 #include <limits>
+#include <fstream>
+#include <memory>
+#include <string_view>
 #include "Resource.h"
 #include "Slot.h"
+#include "Parser.h"
+#include "Log.h"
+#include "Metrics.h"
+#include "Trace.h"
+#include "SmallVector.h"
 
 using namespace std;
 
@@ -24,13 +32,27 @@ struct SlotNode {
 class Lab: public Resource {
 protected:
     // Root of the Binary Search Tree (BST) to manage slots
-    SlotNode* slots_tree = nullptr; 
+    mutable SlotNode* slots_tree = nullptr; 
 
-    // Stores User IDs (int) of those waiting for a slot
-    queue<int> waitlist; 
+    // Stores User IDs (int) of those waiting for a slot; empty waitlists own no memory
+    mutable CompactQueue<int> waitlist; 
+
+    // Lazy loading: the slots and waitlist are only built the first time the lab is used.
+    // A lab loaded from file remembers where its "Slots:...|Waitlist:..." text is;
+    // a new lab gets the default slots.
+    mutable bool slots_loaded = false;
+    mutable shared_ptr<const string> slot_source_path;
+    streamoff slot_source_offset = 0;
+    size_t slot_source_length = 0;
+
+    // Builds the slot tree and waitlist if this has not happened yet
+    void ensureSlotsLoaded() const;
+    // Parses "Slots:SId,Day,Start,End,Booked;...|Waitlist:UId,UId,..." into the tree and waitlist.
+    // Malformed slots and waitlist entries are skipped and described in problems.
+    void parseSlotData(string_view data, vector<string>& problems) const;
 
     // Inserts a new slot into the BST based on its ID
-    SlotNode* insertSlotNode(SlotNode* node, const Slot& slot);
+    static SlotNode* insertSlotNode(SlotNode* node, const Slot& slot);
     // Searches for a slot node based on its ID
     SlotNode* findSlotNode(SlotNode* node, int slotId) const;
     // Traverses the tree (in-order) to collect all slots into a vector
@@ -45,15 +67,23 @@ public:
 
     void viewAvailableSlots() const; // Updated to use BST traversal
     bool bookSlot(int slotId); // Updated to use BST search
+    bool isSlotFree(int slotId) const; // Slot exists and is not booked
     bool cancelSlotBooking(int slotId); // Updated to use BST search
     void addLabSlots(); // Initializes default slots
+    static vector<Slot> defaultSlots();
     Slot getSlot(int id) const; // Updated to use BST search
     vector<Slot> getSlots() const; // Updated to use BST traversal
 
     void addToWaitlist(int userId);
     int processWaitlist(); // Removes the user from the front of the queue and returns their ID
-    queue<int> getWaitlist() const;
-    void loadWaitlist(int userId) { waitlist.push(userId); } // For loading from file
+    const CompactQueue<int>& getWaitlist() const;
+    void loadWaitlist(int userId) { ensureSlotsLoaded(); waitlist.push(userId); markDirty(); } // For loading from file
+
+    // Points the lab at its slot/waitlist text in a data file instead of parsing it now
+    void setSlotSource(shared_ptr<const string> path, streamoff offset, size_t length);
+    bool slotsLoaded() const { return slots_loaded; }
+    // Loads the slots if needed; false if their text could not be read, so the lab must not be saved
+    bool slotsAvailable() const { ensureSlotsLoaded(); return slots_loaded; }
 
     Lab();
     Lab(int id, const string& name, const string& type, Location location, bool available);
@@ -117,7 +147,6 @@ Lab::Lab() {
     setType("");
     setLocation(Location());
     setAvailability(true);
-    addLabSlots();
 }
 
 Lab::Lab(int id, const string& name, const string& type, Location location, bool available) {
@@ -126,7 +155,6 @@ Lab::Lab(int id, const string& name, const string& type, Location location, bool
     setType(type);
     setLocation(location);
     setAvailability(available);
-    addLabSlots();
 }
 
 Lab::~Lab() {
@@ -134,19 +162,23 @@ Lab::~Lab() {
 }
 
 Slot Lab::getSlot(int id) const {
+    ensureSlotsLoaded();
     SlotNode* node = findSlotNode(slots_tree, id);
     if (node) {
         return node->slot;
     }
-    cout << "\nSlot not found." << endl;
+    engine_log.info("booking", "Slot not found.");
     return Slot();
 }
 
 void Lab::addSlot(const Slot& slot) {
+    ensureSlotsLoaded();
     slots_tree = insertSlotNode(slots_tree, slot);
+    markDirty();
 }
 
 void Lab::viewAvailableSlots() const {
+    ensureSlotsLoaded();
     cout << "\nAvailable slots for Lab '" << getName() << "' (id=" << getId() << "):\n";
     if (slots_tree == nullptr) {
         cout << "  (no slots defined)\n";
@@ -156,72 +188,172 @@ void Lab::viewAvailableSlots() const {
 }
 
 bool Lab::bookSlot(int slotId) {
+    MetricTimer timer(Metric::BookSlot);
+    ensureSlotsLoaded();
     SlotNode* node = findSlotNode(slots_tree, slotId);
     if (node && !node->slot.isBooked) {
         node->slot.isBooked = true;
+        markDirty();
         return true;
     }
+    timer.fail();
     return false;
 }
 
+bool Lab::isSlotFree(int slotId) const {
+    ensureSlotsLoaded();
+    SlotNode* node = findSlotNode(slots_tree, slotId);
+    return node && !node->slot.isBooked;
+}
+
 bool Lab::cancelSlotBooking(int slotId) {
+    MetricTimer timer(Metric::CancelSlot);
+    ensureSlotsLoaded();
     SlotNode* node = findSlotNode(slots_tree, slotId);
     if (node && node->slot.isBooked) {
         node->slot.isBooked = false;
-        
+        markDirty();
+
         // ? After cancellation, check and process the waitlist
         if (!waitlist.empty()) {
             int next_user_id = processWaitlist();
-            cout << "\nSlot " << slotId << " canceled and freed up.\n";
-            cout << "Waitlist notification: User ID " << next_user_id << " is next in line for this resource.\n";
+            engine_log.info("booking", "Slot ", slotId, " canceled and freed up.");
+            engine_log.info("waitlist", "Waitlist notification: User ID ", next_user_id, " is next in line for this resource.");
         } else {
-            cout << "\nSlot " << slotId << " canceled and freed up. Waitlist is empty.\n";
+            engine_log.info("booking", "Slot ", slotId, " canceled and freed up. Waitlist is empty.");
         }
         return true;
     }
+    timer.fail();
     return false;
 }
 
 vector<Slot> Lab::getSlots() const {
+    ensureSlotsLoaded();
     vector<Slot> all_slots;
     inorderTraversal(slots_tree, all_slots);
     return all_slots;
 }
 
+vector<Slot> Lab::defaultSlots() {
+    return {
+        Slot(1,"Monday","08:00","10:00"),
+        Slot(2,"Monday","10:00","12:00"),
+        Slot(3,"Monday","12:00","14:00"),
+        Slot(4,"Monday","14:00","16:00"),
+        Slot(5,"Tuesday","08:00","10:00"),
+        Slot(6,"Tuesday","10:00","12:00"),
+        Slot(7,"Wednesday","14:00","16:00")
+    };
+}
+
 void Lab::addLabSlots(){
-    Slot monday1(1,"Monday","08:00","10:00");
-    Slot monday2(2,"Monday","10:00","12:00");
-    Slot monday3(3,"Monday","12:00","14:00");
-    Slot monday4(4,"Monday","14:00","16:00");
-    Slot tuesday1(5,"Tuesday","08:00","10:00");
-    Slot tuesday2(6,"Tuesday","10:00","12:00");
-    Slot wednesday1(7,"Wednesday","14:00","16:00");
-    
-    addSlot(monday1);
-    addSlot(monday2);
-    addSlot(monday3);
-    addSlot(monday4);
-    addSlot(tuesday1);
-    addSlot(tuesday2);
-    addSlot(wednesday1);
+    for (const Slot& slot : defaultSlots()) {
+        addSlot(slot);
+    }
+}
+
+void Lab::setSlotSource(shared_ptr<const string> path, streamoff offset, size_t length) {
+    deleteTree(slots_tree);
+    slots_tree = nullptr;
+    waitlist.clear();
+    slot_source_path = move(path);
+    slot_source_offset = offset;
+    slot_source_length = length;
+    slots_loaded = false;
+}
+
+void Lab::ensureSlotsLoaded() const {
+    if (slots_loaded) {
+        return;
+    }
+    if (!slot_source_path) {
+        // New lab: start from the default timetable
+        for (const Slot& slot : defaultSlots()) {
+            slots_tree = insertSlotNode(slots_tree, slot);
+        }
+        slots_loaded = true;
+        return;
+    }
+
+    TraceSpan span("storage", "load_slots", getName());
+    string data(slot_source_length, '\0');
+    ifstream infile(*slot_source_path, ios::binary);
+    infile.seekg(slot_source_offset);
+    infile.read(&data[0], static_cast<streamsize>(slot_source_length));
+    if (!infile || static_cast<size_t>(infile.gcount()) != slot_source_length) {
+        // Stay unloaded: the lab shows no slots, and is tried again (and not saved) until it reads
+        engine_log.error("storage", "could not read slots for resource ", getId(), " from ", *slot_source_path, ".");
+        return;
+    }
+
+    vector<string> problems;
+    parseSlotData(data, problems);
+    for (const string& problem : problems) {
+        engine_log.warn("storage", "resource ", getId(), " in ", *slot_source_path, ": skipped ", problem, ".");
+    }
+    slots_loaded = true;
+    slot_source_path.reset();
+}
+
+void Lab::parseSlotData(string_view data, vector<string>& problems) const {
+    string_view fields[2];
+    if (split_fields(data, '|', fields, 2) < 2) {
+        problems.push_back("missing Waitlist section");
+        fields[1] = string_view();
+    }
+
+    // 1. Slots: SId,Day,Start,End,Booked;...
+    FieldSplitter slot_splitter(after_label(fields[0]), ';');
+    string_view slot_segment;
+    while (slot_splitter.next(slot_segment)) {
+        if (slot_segment.empty()) continue;
+        string_view s_parts[5];
+        int slot_id;
+        if (split_fields(slot_segment, ',', s_parts, 5) != 5 || !parse_int(s_parts[0], slot_id)) {
+            problems.push_back("invalid slot '" + string(slot_segment) + "'");
+            continue;
+        }
+        Slot s(slot_id, string(s_parts[1]), string(s_parts[2]), string(s_parts[3]));
+        s.isBooked = (s_parts[4] == "1");
+        slots_tree = insertSlotNode(slots_tree, s);
+    }
+
+    // 2. Waitlist: UId,UId,...
+    FieldSplitter waitlist_splitter(after_label(fields[1]), ',');
+    string_view user_segment;
+    while (waitlist_splitter.next(user_segment)) {
+        if (user_segment.empty()) continue;
+        int user_id;
+        if (!parse_int(user_segment, user_id)) {
+            problems.push_back("invalid waitlist user id '" + string(user_segment) + "'");
+            continue;
+        }
+        waitlist.push(user_id);
+    }
 }
 
 void Lab::addToWaitlist(int userId) {
+    ensureSlotsLoaded();
     waitlist.push(userId);
-    cout << "\nUser ID " << userId << " added to waitlist for " << getName() << ". You are #" << waitlist.size() << " in line.\n";
+    markDirty();
+    engine_log.info("waitlist", "User ID ", userId, " added to waitlist for ", getName(), ". You are #", waitlist.size(), " in line.");
 }
 
 int Lab::processWaitlist() {
+    ensureSlotsLoaded();
     if (waitlist.empty()) {
         return 0; // No user in the waitlist
     }
     int next_user_id = waitlist.front(); // Get the first user
     waitlist.pop(); // Remove them from the queue
+    markDirty();
     return next_user_id;
 }
 
-queue<int> Lab::getWaitlist() const {
-    return waitlist; // Return a copy of the current waitlist queue
+const CompactQueue<int>& Lab::getWaitlist() const {
+    ensureSlotsLoaded();
+    return waitlist;
 }
 
 
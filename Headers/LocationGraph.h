@@ -1,20 +1,26 @@
 #ifndef LOCATIONGRAPH_H
 #define LOCATIONGRAPH_H
 
-#include "Location.h"
+#include "Resource.h"
+#include "CSRGraph.h"
 #include <unordered_map>
 #include <vector>
 #include <utility>
+#include <queue>
 #include <limits>
+#include <algorithm>
 
+/**
+ * @brief Small graph with integer ids, used for the rooms, corridors and stairs inside one building.
+ */
 class LocationGraph {
 public:
     LocationGraph();
 
     // Add a location (node). If a node with same id exists, it will be overwritten.
-    void addLocation(const Location& loc);
+    void addLocation(int id, const Location& loc);
 
-    // Add a directed edge from 'fromId' to 'toId' with given weight (distance/time)
+    // Add an undirected edge between 'fromId' and 'toId' with given weight (distance/time)
     void addEdge(int fromId, int toId, double weight);
 
     // Get neighbors (id, weight)
@@ -23,9 +29,17 @@ public:
     // Get Location by id (returns nullptr if not found)
     const Location* getLocation(int id) const;
 
+    // Id of the location with the given name, or -1
+    int idOf(const std::string& name) const;
+
+    size_t size() const { return nodes_.size(); }
+
     // Shortest path using Dijkstra: returns vector of location ids in path order, empty if no path
     std::vector<int> shortestPath(int fromId, int toId) const;
 
+    // Shortest path with the weight of every segment
+    BasicRoute<int> route(int fromId, int toId) const;
+
 private:
     std::unordered_map<int, Location> nodes_;
     std::unordered_map<int, std::vector<std::pair<int,double>>> adj_;
@@ -34,13 +48,17 @@ private:
 
 LocationGraph::LocationGraph() = default;
 
-void LocationGraph::addLocation(const Location& loc) {
-    nodes_[loc.getId()] = loc;
+void LocationGraph::addLocation(int id, const Location& loc) {
+    nodes_.erase(id);
+    nodes_.emplace(id, loc);
+    // ensure adjacency entry exists
+    if (adj_.find(id) == adj_.end()) adj_[id] = {};
 }
 
 void LocationGraph::addEdge(int fromId, int toId, double weight) {
-    // ensure nodes exist (no-op if absent; caller should add nodes first normally)
+    // ensure nodes exist (caller responsibility to add locations first is recommended)
     adj_[fromId].push_back({toId, weight});
+    adj_[toId].push_back({fromId, weight}); // undirected
 }
 
 std::vector<std::pair<int,double>> LocationGraph::neighbors(int id) const {
@@ -55,98 +73,27 @@ const Location* LocationGraph::getLocation(int id) const {
     return &it->second;
 }
 
-std::vector<int> LocationGraph::shortestPath(int fromId, int toId) const {
-    // Dijkstra over integer node ids
-    const double INF = std::numeric_limits<double>::infinity();
-
-    // distances and predecessor maps
-    std::unordered_map<int,double> dist;
-    std::unordered_map<int,int> prev;
-
-    // min-heap (dist, node)
-    using PD = std::pair<double,int>;
-    std::priority_queue<PD, std::vector<PD>, std::greater<PD>> pq;
-
-    // init
+int LocationGraph::idOf(const std::string& name) const {
     for (const auto& kv : nodes_) {
-        dist[kv.first] = INF;
-    }
-    if (dist.find(fromId) == dist.end() || dist.find(toId) == dist.end()) return {};
-
-    dist[fromId] = 0.0;
-    pq.push({0.0, fromId});
-
-    while (!pq.empty()) {
-        auto [d,u] = pq.top(); pq.pop();
-        if (d > dist[u]) continue;
-        if (u == toId) break;
-        auto it = adj_.find(u);
-        if (it == adj_.end()) continue;
-        for (const auto& [v, w] : it->second) {
-            double nd = d + w;
-            if (nd < dist[v]) {
-                dist[v] = nd;
-                prev[v] = u;
-                pq.push({nd, v});
-            }
-        }
+        if (kv.second.getName() == name) return kv.first;
     }
-
-    if (dist[toId] == INF) return {};
-
-    // reconstruct path
-    std::vector<int> path;
-    int cur = toId;
-    while (true) {
-        path.push_back(cur);
-        if (cur == fromId) break;
-        auto itp = prev.find(cur);
-        if (itp == prev.end()) return {}; // no path
-        cur = itp->second;
-    }
-    std::reverse(path.begin(), path.end());
-    return path;
+    return -1;
 }
 
-
-#include "../Headers/LocationGraph.h"
-#include <queue>
-#include <unordered_map>
-#include <limits>
-
-void LocationGraph::addLocation(const Location& loc) {
-    nodes_[loc.getId()] = loc;
-    // ensure adjacency entry exists
-    if (adj_.find(loc.getId()) == adj_.end()) adj_[loc.getId()] = {};
-}
-
-void LocationGraph::addEdge(int fromId, int toId, double weight) {
-    // ensure nodes exist (caller responsibility to add locations first is recommended)
-    adj_[fromId].push_back({toId, weight});
-    adj_[toId].push_back({fromId, weight}); // undirected
-}
-
-std::vector<std::pair<int,double>> LocationGraph::neighbors(int id) const {
-    auto it = adj_.find(id);
-    if (it == adj_.end()) return {};
-    return it->second;
+std::vector<int> LocationGraph::shortestPath(int startId, int endId) const {
+    return route(startId, endId).path;
 }
 
-std::vector<int> LocationGraph::shortestPath(int startId, int endId) const {
-    const double INF = std::numeric_limits<double>::infinity();
+BasicRoute<int> LocationGraph::route(int startId, int endId) const {
+    BasicRoute<int> result;
     std::unordered_map<int, double> dist;
-    std::unordered_map<int, int> prev;
+    std::unordered_map<int, std::pair<int,double>> prev; // node -> (previous node, edge weight)
 
     // Min-heap (distance, node)
     using Pair = std::pair<double,int>;
     std::priority_queue<Pair, std::vector<Pair>, std::greater<Pair>> pq;
 
-    // initialize distances
-    for (const auto& kv : nodes_) {
-        dist[kv.first] = INF;
-    }
-
-    if (nodes_.find(startId) == nodes_.end() || nodes_.find(endId) == nodes_.end()) return {};
+    if (nodes_.find(startId) == nodes_.end() || nodes_.find(endId) == nodes_.end()) return result;
 
     dist[startId] = 0.0;
     pq.push({0.0, startId});
@@ -159,28 +106,31 @@ std::vector<int> LocationGraph::shortestPath(int startId, int endId) const {
         if (it == adj_.end()) continue;
         for (const auto& [v, w] : it->second) {
             double nd = d + w;
-            if (nd < dist[v]) {
+            auto dv = dist.find(v);
+            if (dv == dist.end() || nd < dv->second) {
                 dist[v] = nd;
-                prev[v] = u;
+                prev[v] = {u, w};
                 pq.push({nd, v});
             }
         }
     }
 
-    if (dist[endId] == INF) return {};
+    if (dist.find(endId) == dist.end()) return result;
 
     // reconstruct path
-    std::vector<int> path;
+    result.distance = dist[endId];
     int cur = endId;
     while (cur != startId) {
-        path.push_back(cur);
+        result.path.push_back(cur);
         auto itp = prev.find(cur);
-        if (itp == prev.end()) return {}; // should not happen
-        cur = itp->second;
+        if (itp == prev.end()) return BasicRoute<int>(); // should not happen
+        result.segment_weights.push_back(itp->second.second);
+        cur = itp->second.first;
     }
-    path.push_back(startId);
-    std::reverse(path.begin(), path.end());
-    return path;
+    result.path.push_back(startId);
+    std::reverse(result.path.begin(), result.path.end());
+    std::reverse(result.segment_weights.begin(), result.segment_weights.end());
+    return result;
 }
 
 
@@ -0,0 +1,322 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <type_traits>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+using namespace std;
+
+enum class LogLevel { Debug, Info, Warn, Error, Off };
+
+// Parses "debug", "info", "warn", "error" or "off"
+bool parse_log_level(string_view text, LogLevel& level) {
+    static const char* names[] = {"debug", "info", "warn", "error", "off"};
+    for (int i = 0; i < 5; ++i) {
+        if (text == names[i]) {
+            level = static_cast<LogLevel>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Records the ring holds. When it is full a producer gives the writer a few chances to catch
+// up, then drops its record rather than stall the engine.
+const size_t LOG_RING_CAPACITY = 8192;
+const int LOG_FULL_RETRIES = 16;
+// Longer messages are cut short
+const size_t LOG_TEXT_BYTES = 200;
+// How long the writer sleeps when the ring is quiet
+const int LOG_WRITER_INTERVAL_MS = 10;
+
+/**
+ * @brief Asynchronous, levelled event log for the engine.
+ *
+ * Engine code emits events (level, category and message parts) instead of writing to cout.
+ * An event below the current level costs one atomic load. Otherwise its parts are formatted
+ * straight into a slot of a fixed lock-free ring buffer (no allocation, no locks), and a
+ * background thread writes the slots out in batches. Console sinks show the message as the menu
+ * always did; file sinks get one timestamped "LEVEL category: message" line per event.
+ */
+class Logger {
+private:
+    struct Record {
+        atomic<uint64_t> sequence{0}; // ring protocol: == position when free, position + 1 when full
+        LogLevel level = LogLevel::Info;
+        const char* category = "";
+        int64_t time_ns = 0;
+        uint16_t length = 0;
+        char text[LOG_TEXT_BYTES];
+    };
+
+    vector<Record> ring;
+    atomic<uint64_t> tail{0};  // next position producers claim
+    atomic<uint64_t> head{0};  // next position the writer reads (writer thread only)
+    atomic<int> min_level{static_cast<int>(LogLevel::Info)};
+    atomic<uint64_t> dropped{0};       // not yet reported by the writer
+    atomic<uint64_t> dropped_total{0};
+
+    mutex sink_lock;           // guards the sink settings below and the writer's waits
+    ostream* sink = &cout;
+    ofstream file_sink;
+    bool plain = true;         // console format (message only) rather than timestamped lines
+    atomic<bool> immediate{false};
+
+    condition_variable wake_writer;
+    condition_variable drained;
+    atomic<bool> writer_waiting{false};
+    bool stopping = false;
+    thread writer;
+
+    // Writer thread only: timestamp text of the last second formatted
+    int64_t stamp_second = -1;
+    char stamp[32];
+
+    void writerLoop();
+    bool drain(string& batch);
+    void formatRecord(const Record& record, string& batch);
+
+    static void append(char*& cursor, char* end, string_view text) {
+        size_t count = min(text.size(), static_cast<size_t>(end - cursor));
+        text.copy(cursor, count);
+        cursor += count;
+    }
+    static void append(char*& cursor, char* end, const char* text) { append(cursor, end, string_view(text)); }
+    static void append(char*& cursor, char* end, const string& text) { append(cursor, end, string_view(text)); }
+    static void append(char*& cursor, char* end, char c) {
+        if (cursor < end) *cursor++ = c;
+    }
+    static void append(char*& cursor, char* end, double value) {
+        char digits[32];
+        int count = snprintf(digits, sizeof(digits), "%.1f", value);
+        append(cursor, end, string_view(digits, static_cast<size_t>(max(0, count))));
+    }
+    template <class T, class = enable_if_t<is_integral_v<T> && !is_same_v<T, char> && !is_same_v<T, bool>>>
+    static void append(char*& cursor, char* end, T value) {
+        cursor = to_chars(cursor, end, value).ptr; // leaves the cursor as is when out of room
+    }
+
+    void push(LogLevel level, const char* category, const char* text, size_t length);
+
+public:
+    Logger() : ring(LOG_RING_CAPACITY) {
+        for (size_t i = 0; i < ring.size(); ++i) {
+            ring[i].sequence.store(i, memory_order_relaxed);
+        }
+        writer = thread(&Logger::writerLoop, this);
+    }
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    bool enabled(LogLevel level) const {
+        return static_cast<int>(level) >= min_level.load(memory_order_relaxed);
+    }
+    void setLevel(LogLevel level) { min_level.store(static_cast<int>(level), memory_order_relaxed); }
+    LogLevel level() const { return static_cast<LogLevel>(min_level.load(memory_order_relaxed)); }
+
+    // Writes events to a console stream, showing just the message (warnings and errors prefixed)
+    void toConsole(ostream& stream);
+    // Appends timestamped events to a file; false if it cannot be opened
+    bool toFile(const string& path);
+
+    /**
+     * @brief With immediate set, each event is written before emit() returns, keeping it in
+     * order with the interactive menu's own output. Bulk and server work leaves it off.
+     */
+    void setImmediate(bool on) { immediate = on; }
+
+    // Records an event made of the given parts (strings, characters and numbers)
+    template <class... Parts>
+    void emit(LogLevel level, const char* category, const Parts&... parts) {
+        if (!enabled(level)) {
+            return;
+        }
+        char text[LOG_TEXT_BYTES];
+        char* cursor = text;
+        (append(cursor, text + LOG_TEXT_BYTES, parts), ...);
+        push(level, category, text, static_cast<size_t>(cursor - text));
+    }
+    template <class... Parts> void debug(const char* category, const Parts&... parts) { emit(LogLevel::Debug, category, parts...); }
+    template <class... Parts> void info(const char* category, const Parts&... parts) { emit(LogLevel::Info, category, parts...); }
+    template <class... Parts> void warn(const char* category, const Parts&... parts) { emit(LogLevel::Warn, category, parts...); }
+    template <class... Parts> void error(const char* category, const Parts&... parts) { emit(LogLevel::Error, category, parts...); }
+
+    // Blocks until every event emitted so far has been written
+    void flush();
+
+    uint64_t droppedCount() const { return dropped_total.load(memory_order_relaxed); }
+};
+
+// The engine's log
+Logger engine_log;
+
+Logger::~Logger() {
+    {
+        lock_guard<mutex> guard(sink_lock);
+        stopping = true;
+    }
+    wake_writer.notify_one();
+    writer.join();
+}
+
+void Logger::push(LogLevel level, const char* category, const char* text, size_t length) {
+    // Bounded multi-producer queue: claim a position, fill its slot, then publish it
+    uint64_t position = tail.load(memory_order_relaxed);
+    Record* record;
+    int retries = 0;
+    while (true) {
+        record = &ring[position % ring.size()];
+        uint64_t sequence = record->sequence.load(memory_order_acquire);
+        if (sequence == position) {
+            if (tail.compare_exchange_weak(position, position + 1, memory_order_relaxed)) break;
+        } else if (sequence < position) {
+            // The writer is a full ring behind
+            if (retries++ == LOG_FULL_RETRIES) {
+                dropped.fetch_add(1, memory_order_relaxed);
+                dropped_total.fetch_add(1, memory_order_relaxed);
+                return;
+            }
+            if (writer_waiting.exchange(false, memory_order_relaxed)) {
+                wake_writer.notify_one();
+            }
+            this_thread::yield();
+            position = tail.load(memory_order_relaxed);
+        } else {
+            position = tail.load(memory_order_relaxed);
+        }
+    }
+    record->level = level;
+    record->category = category;
+    record->time_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::system_clock::now().time_since_epoch()).count();
+    record->length = static_cast<uint16_t>(length);
+    memcpy(record->text, text, length);
+    record->sequence.store(position + 1, memory_order_release);
+
+    // The writer wakes by itself every few milliseconds; it is only woken early when a quarter
+    // of the ring is waiting, so bursts are written in large batches without a wakeup per event
+    if (immediate) {
+        flush();
+    } else if (position - head.load(memory_order_relaxed) >= ring.size() / 4
+               && writer_waiting.exchange(false, memory_order_relaxed)) {
+        wake_writer.notify_one();
+    }
+}
+
+void Logger::toConsole(ostream& stream) {
+    flush();
+    lock_guard<mutex> guard(sink_lock);
+    file_sink.close();
+    sink = &stream;
+    plain = true;
+}
+
+bool Logger::toFile(const string& path) {
+    flush();
+    lock_guard<mutex> guard(sink_lock);
+    file_sink.close();
+    file_sink.open(path, ios::app);
+    if (!file_sink.is_open()) {
+        return false;
+    }
+    sink = &file_sink;
+    plain = false;
+    return true;
+}
+
+void Logger::formatRecord(const Record& record, string& batch) {
+    static const char* level_names[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+    string_view text(record.text, record.length);
+    if (plain) {
+        if (record.level == LogLevel::Warn) batch += "Warning: ";
+        if (record.level == LogLevel::Error) batch += "ERROR: ";
+    } else {
+        int64_t second = record.time_ns / 1000000000;
+        if (second != stamp_second) {
+            time_t seconds = static_cast<time_t>(second);
+            tm utc;
+            gmtime_r(&seconds, &utc);
+            strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%S", &utc);
+            stamp_second = second;
+        }
+        batch += stamp;
+        char millis[8];
+        snprintf(millis, sizeof(millis), ".%03dZ ", static_cast<int>(record.time_ns / 1000000 % 1000));
+        batch += millis;
+        batch += level_names[static_cast<int>(record.level)];
+        batch += ' ';
+        batch += record.category;
+        batch += ": ";
+    }
+    batch += text;
+    batch += '\n';
+}
+
+bool Logger::drain(string& batch) {
+    uint64_t position = head.load(memory_order_relaxed);
+    bool any = false;
+    while (true) {
+        Record& record = ring[position % ring.size()];
+        if (record.sequence.load(memory_order_acquire) != position + 1) {
+            break;
+        }
+        formatRecord(record, batch);
+        record.sequence.store(position + ring.size(), memory_order_release);
+        position++;
+        any = true;
+    }
+    head.store(position, memory_order_release);
+    return any;
+}
+
+void Logger::writerLoop() {
+    string batch;
+    unique_lock<mutex> guard(sink_lock);
+    while (true) {
+        batch.clear();
+        bool wrote = drain(batch);
+        uint64_t lost = dropped.exchange(0, memory_order_relaxed);
+        if (lost > 0) {
+            batch += "Warning: " + to_string(lost) + " log events dropped (log ring full).\n";
+        }
+        if (!batch.empty()) {
+            sink->write(batch.data(), static_cast<streamsize>(batch.size()));
+            sink->flush();
+        }
+        drained.notify_all();
+        if (wrote) {
+            continue;
+        }
+        if (stopping) {
+            return;
+        }
+        writer_waiting.store(true, memory_order_relaxed);
+        wake_writer.wait_for(guard, chrono::milliseconds(LOG_WRITER_INTERVAL_MS));
+        writer_waiting.store(false, memory_order_relaxed);
+    }
+}
+
+void Logger::flush() {
+    uint64_t target = tail.load(memory_order_acquire);
+    unique_lock<mutex> guard(sink_lock);
+    while (head.load(memory_order_acquire) < target) {
+        wake_writer.notify_one();
+        drained.wait_for(guard, chrono::milliseconds(5));
+    }
+}
+
+#endif // LOG_H
@@ -10,20 +10,75 @@
 #include <algorithm>
 #include <iomanip>
 
+#include <memory>
+#include <filesystem>
+
+#include "CSRGraph.h"
+#include "RouteTable.h"
+#include "RouteCache.h"
+#include "ContractionHierarchy.h"
+#include "DistanceMatrix.h"
+#include "Resource.h"
+#include "Parser.h"
+#include "Log.h"
+#include "Metrics.h"
+#include "Trace.h"
+
 using namespace std;
 
-// Infinity value for distances
-const double INF = numeric_limits<double>::infinity();
 using WeightVertexPair = pair<double, string>;
 using Edge = pair<string, double>;
+using Route = BasicRoute<string>;
+
+/**
+ * @brief One edit of a walkway, as recorded in the map's change log (INF = no walkway).
+ */
+struct PathChange {
+    uint64_t revision; // map revision after the change
+    string from;
+    string to;
+    double old_weight;
+    double new_weight;
+};
+
+// Number of recent walkway changes kept for consumers that repair their caches incrementally
+const size_t PATH_CHANGE_LOG_SIZE = 1024;
 
 /**
  * @brief Represents the NUL map with specified buildings.
  */
 class NULMapGraph {
 private:
+    // Closed walkways stay listed with weight INF, so set_path_weight can reopen them
     map<string, vector<Edge>> adj_list;
 
+    // Optional building positions (metres), used for A* once the map is frozen
+    map<string, pair<double, double>> coordinates;
+
+    // Compiled form used for routing once the map is frozen (see freeze())
+    CSRGraph compiled;
+    bool frozen = false;
+
+    // Set when the map was mapped from a graph file: adj_list and coordinates are empty and are
+    // rebuilt from the compiled graph the first time the map is edited (see load_map())
+    bool adjacency_pending = false;
+
+    // Bumped on every edit, so callers can tell when routes they cached are stale
+    uint64_t revision_number = 0;
+
+    // Recent weight changes and removals, oldest first (see changes_since())
+    vector<PathChange> change_log;
+    uint64_t log_start_revision = 0; // changes after this revision are all in change_log
+
+    // Optional all-pairs table over the compiled graph (see precompute_routes())
+    shared_ptr<RouteTable> route_table;
+
+    // Optional contraction hierarchy over the compiled graph (see prepare_hierarchy())
+    shared_ptr<const ContractionHierarchy> hierarchy;
+
+    // Recently answered queries, tagged with the revision they were computed at
+    mutable RouteCache route_cache;
+
     vector<string> reconstruct_path(const string& start_node, const string& end_node,
                                     const map<string, string>& previous_node) const {
         vector<string> path;
@@ -42,33 +97,516 @@ private:
         return path;
     }
 
+    // Converts a route over compiled node ids to building names
+    Route to_named_route(NodeRoute ids) const {
+        Route route;
+        route.distance = ids.distance;
+        route.segment_weights = move(ids.segment_weights);
+        for (uint32_t id : ids.path) {
+            route.path.emplace_back(compiled.nameOf(id));
+        }
+        return route;
+    }
+
+    // Rebuilds adj_list and coordinates from a graph mapped by load_map(), before an edit
+    void materialize_adjacency() {
+        if (!adjacency_pending) {
+            return;
+        }
+        adjacency_pending = false;
+        for (uint32_t u = 0; u < compiled.nodeCount(); ++u) {
+            vector<Edge>& edges = adj_list[string(compiled.nameOf(u))];
+            for (uint32_t arc = compiled.arcBegin(u); arc < compiled.arcEnd(u); ++arc) {
+                edges.push_back({string(compiled.nameOf(compiled.arcTarget(arc))), compiled.arcWeight(arc)});
+            }
+            if (compiled.hasPositions()) {
+                coordinates[string(compiled.nameOf(u))] = {compiled.x(u), compiled.y(u)};
+            }
+        }
+    }
+
+    // Sets the weight of every u <-> v walkway entry (INF closes them). Returns the old weight.
+    double set_adjacency_weight(const string& u, const string& v, double weight) {
+        double old_weight = INF;
+        auto it = adj_list.find(u);
+        if (it == adj_list.end()) {
+            return INF;
+        }
+        for (Edge& edge : it->second) {
+            if (edge.first == v) {
+                old_weight = min(old_weight, edge.second);
+                edge.second = weight;
+            }
+        }
+        return old_weight;
+    }
+
+    // Whether a walkway between u and v was ever added, open or closed
+    bool has_walkway(const string& u, const string& v) const {
+        if (adjacency_pending) {
+            uint32_t a = compiled.idOf(u), b = compiled.idOf(v);
+            return a != NO_NODE && b != NO_NODE && compiled.findArc(a, b) != NO_NODE;
+        }
+        auto it = adj_list.find(u);
+        return it != adj_list.end() &&
+               any_of(it->second.begin(), it->second.end(), [&v](const Edge& edge) { return edge.first == v; });
+    }
+
+    bool update_path(const string& u, const string& v, double weight) {
+        if (!has_walkway(u, v)) {
+            return false;
+        }
+        double old_weight = get_edge_weight(u, v);
+        materialize_adjacency();
+        set_adjacency_weight(u, v, weight);
+        set_adjacency_weight(v, u, weight);
+        revision_number++;
+        change_log.push_back({revision_number, u, v, old_weight, weight});
+        if (change_log.size() > PATH_CHANGE_LOG_SIZE) {
+            log_start_revision = change_log.front().revision;
+            change_log.erase(change_log.begin());
+        }
+
+        if (frozen) {
+            // Same buildings, so node ids are unchanged: patch the compiled arcs in place
+            uint32_t a = compiled.idOf(u), b = compiled.idOf(v);
+            vector<ArcChange> arc_changes;
+            for (auto ends : {make_pair(a, b), make_pair(b, a)}) {
+                for (uint32_t arc = compiled.arcBegin(ends.first); arc < compiled.arcEnd(ends.first); ++arc) {
+                    if (compiled.arcTarget(arc) != ends.second) continue;
+                    arc_changes.push_back({ends.first, ends.second, compiled.arcWeight(arc), weight});
+                    compiled.setArcWeight(arc, weight);
+                }
+            }
+            if (route_table) {
+                route_table->repair(compiled, arc_changes);
+            }
+            if (hierarchy) {
+                // Shortcuts were chosen for the old weights (a witness route that got slower may
+                // now need a shortcut it never got), so the map is contracted again
+                engine_log.warn("map", "walkway ", u, " - ", v, " changed; rebuilding the contraction hierarchy.");
+                prepare_hierarchy();
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Whether a route cached at revision `since` is still a shortest route. Slower or
+     * closed walkways only invalidate routes that walk along them; a faster walkway (or a new
+     * one) can shorten any route.
+     */
+    bool route_survives(const Route& route, uint64_t since) const {
+        vector<PathChange> changes;
+        if (!changes_since(since, changes)) {
+            return false;
+        }
+        for (const PathChange& change : changes) {
+            if (change.new_weight < change.old_weight) return false;
+        }
+        const vector<string>& path = route.path;
+        for (size_t i = 0; i + 1 < path.size(); ++i) {
+            for (const PathChange& change : changes) {
+                if ((path[i] == change.from && path[i + 1] == change.to) || (path[i] == change.to && path[i + 1] == change.from)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Uncached query behind shortest_route()
+    Route search_route(const string& start_node, const string& end_node) const {
+        Route route;
+        if (frozen) {
+            // One scratch per thread, reused across queries
+            thread_local SearchScratch scratch;
+            uint32_t source = compiled.idOf(start_node);
+            uint32_t target = compiled.idOf(end_node);
+            if (route_table) {
+                return to_named_route(route_table->route(compiled, source, target));
+            }
+            if (hierarchy) {
+                thread_local HierarchyScratch hierarchy_scratch;
+                return to_named_route(hierarchy->route(source, target, hierarchy_scratch));
+            }
+            // A* when buildings have coordinates (falls back to Dijkstra order otherwise)
+            return to_named_route(compiled.astarPath(source, target, scratch));
+        }
+
+        auto result = dijkstra_on_adjacency(start_node, end_node);
+        route.path = move(result.first);
+        route.distance = result.second;
+        for (size_t i = 0; i + 1 < route.path.size(); ++i) {
+            route.segment_weights.push_back(get_edge_weight(route.path[i], route.path[i + 1]));
+        }
+        return route;
+    }
+
 public:
     void add_path(const string& u, const string& v, double weight) {
+        materialize_adjacency();
         adj_list[u].push_back({v, weight});
         adj_list[v].push_back({u, weight}); // Undirected graph
+        frozen = false; // compiled graph is stale until the next freeze()
+        revision_number++;
+        change_log.clear(); // new walkways may add buildings: the log no longer covers everything
+        log_start_revision = revision_number;
+        route_table.reset();
+        hierarchy.reset();
     }
 
+    /**
+     * @brief Replaces the map with the buildings and walkways in map_file and freezes it.
+     * Lines are "NODE|name|x|y" (a building and its position in metres; optional) and
+     * "PATH|from|to|minutes"; blank lines and lines starting with '#' are skipped.
+     * The compiled graph is written to graph_file; while that file matches map_file, later
+     * loads map it into memory instead of parsing the text. Returns false if map_file cannot
+     * be read.
+     */
+    bool load_map(const string& map_file, const string& graph_file = "") {
+        TraceSpan span("map", "load_map", map_file);
+        error_code error;
+        SourceStamp stamp;
+        stamp.size = filesystem::file_size(map_file, error);
+        if (error) {
+            return false;
+        }
+        stamp.modified = static_cast<uint64_t>(filesystem::last_write_time(map_file, error).time_since_epoch().count());
+
+        adj_list.clear();
+        coordinates.clear();
+        adjacency_pending = false;
+        revision_number++;
+        change_log.clear();
+        log_start_revision = revision_number;
+        route_table.reset();
+        hierarchy.reset();
+        route_cache.clear();
+
+        if (!graph_file.empty() && compiled.map(graph_file, stamp)) {
+            frozen = true;
+            adjacency_pending = true;
+            return true;
+        }
+
+        string buffer;
+        if (!read_file_buffer(map_file, buffer)) {
+            return false;
+        }
+        LineReader lines(buffer);
+        string_view line;
+        string_view fields[4];
+        while (lines.next(line)) {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            size_t count = split_fields(line, '|', fields, 4);
+            double a, b;
+            if (count == 4 && fields[0] == "NODE" && parse_double(fields[2], a) && parse_double(fields[3], b)) {
+                adj_list[string(fields[1])];
+                coordinates[string(fields[1])] = {a, b};
+            } else if (count == 4 && fields[0] == "PATH" && parse_double(fields[3], a) && a >= 0.0) {
+                add_path(string(fields[1]), string(fields[2]), a);
+            } else {
+                engine_log.warn("map", map_file, " line ", lines.lineNumber(), ": malformed entry (line skipped).");
+            }
+        }
+        freeze();
+        if (!graph_file.empty() && !compiled.save(graph_file, stamp)) {
+            engine_log.warn("map", "could not write compiled map ", graph_file, ".");
+        }
+        return true;
+    }
+
+    /**
+     * @brief Compiles the map into a CSR graph with dense integer node ids.
+     * Routing queries use the compiled graph until the next add_path.
+     */
+    void freeze() {
+        if (adjacency_pending) {
+            return; // a mapped graph is already compiled
+        }
+        TraceSpan span("map", "freeze");
+        vector<string> names = get_nodes(); // map order: ids follow name order
+        unordered_map<string, uint32_t> ids;
+        for (uint32_t i = 0; i < names.size(); ++i) {
+            ids[names[i]] = i;
+        }
+        vector<Arc> arcs;
+        for (const auto& pair : adj_list) {
+            uint32_t u = ids[pair.first];
+            for (const auto& edge : pair.second) {
+                arcs.push_back({u, ids[edge.first], edge.second});
+            }
+        }
+        compiled.build(move(names), arcs);
+
+        // A* needs a position for every node; otherwise routing stays plain Dijkstra
+        size_t node_count = compiled.nodeCount();
+        if (node_count > 0 && coordinates.size() >= node_count) {
+            vector<double> xs, ys;
+            for (uint32_t id = 0; id < node_count; ++id) {
+                auto it = coordinates.find(string(compiled.nameOf(id)));
+                if (it == coordinates.end()) break;
+                xs.push_back(it->second.first);
+                ys.push_back(it->second.second);
+            }
+            if (xs.size() == node_count) {
+                compiled.setCoordinates(move(xs), move(ys));
+            }
+        }
+        frozen = true;
+        route_table.reset();
+        hierarchy.reset();
+    }
+
+    /**
+     * @brief Precomputes every route of the frozen map so queries need no search.
+     * Loads the table from cache_file when it matches the map, otherwise builds it (one Dijkstra
+     * per node, in parallel) and writes it there. Maps with more than max_nodes nodes are left
+     * to on-demand search. Returns true if the table is in use.
+     */
+    bool precompute_routes(size_t max_nodes = DEFAULT_ROUTE_TABLE_MAX_NODES, const string& cache_file = "") {
+        route_table.reset();
+        if (!frozen || compiled.nodeCount() > max_nodes) {
+            return false;
+        }
+        TraceSpan span("map", "precompute_routes");
+        auto table = make_shared<RouteTable>();
+        if (cache_file.empty() || !table->load(cache_file, compiled)) {
+            table->build(compiled);
+            if (!cache_file.empty() && !table->save(cache_file)) {
+                engine_log.warn("map", "could not write route table cache ", cache_file, ".");
+            }
+        }
+        route_table = table;
+        return true;
+    }
+
+    // Bytes used by the precomputed route table (0 when routes are searched on demand)
+    size_t route_table_bytes() const { return route_table ? route_table->memoryBytes() : 0; }
+
+    /**
+     * @brief Prepares a contraction hierarchy for the frozen map, for maps too large for the
+     * route table. Loads it from cache_file when it matches the map, otherwise contracts the
+     * graph and writes the result there. Returns true if the hierarchy is in use.
+     */
+    bool prepare_hierarchy(const string& cache_file = "") {
+        hierarchy.reset();
+        if (!frozen) {
+            return false;
+        }
+        TraceSpan span("map", "prepare_hierarchy");
+        auto prepared = make_shared<ContractionHierarchy>();
+        if (cache_file.empty() || !prepared->load(cache_file, compiled)) {
+            prepared->build(compiled);
+            if (!cache_file.empty() && !prepared->save(cache_file)) {
+                engine_log.warn("map", "could not write contraction hierarchy cache ", cache_file, ".");
+            }
+        }
+        hierarchy = prepared;
+        return true;
+    }
+
+    const ContractionHierarchy* contraction_hierarchy() const { return hierarchy.get(); }
+
+    /**
+     * @brief Records a building's position in metres. Takes effect at the next freeze().
+     */
+    void set_coordinates(const string& name, double x, double y) {
+        materialize_adjacency();
+        coordinates[name] = {x, y};
+    }
+
+    // Fills in a Location's coordinates from the map node of the same name
+    bool locate(Location& location) const {
+        auto it = coordinates.find(location.getName());
+        if (it == coordinates.end()) {
+            uint32_t id = adjacency_pending && compiled.hasPositions() ? compiled.idOf(location.getName()) : NO_NODE;
+            if (id == NO_NODE) {
+                return false;
+            }
+            location.x = compiled.x(id);
+            location.y = compiled.y(id);
+            location.hasCoordinates = true;
+            return true;
+        }
+        location.x = it->second.first;
+        location.y = it->second.second;
+        location.hasCoordinates = true;
+        return true;
+    }
+
+    /**
+     * @brief Changes the walking time of the walkway between u and v (both directions), and
+     * reopens it if it was closed. On a frozen map the compiled graph is patched in place and the
+     * route table repairs only the rows the change can affect; a contraction hierarchy cannot be
+     * patched, so it is rebuilt (with a warning in the log), which costs a full contraction.
+     * Returns false if there is no such walkway.
+     */
+    bool set_path_weight(const string& u, const string& v, double weight) {
+        return update_path(u, v, weight);
+    }
+
+    /**
+     * @brief Closes the walkway between u and v (construction, events) until set_path_weight
+     * reopens it. Returns false if there is no such walkway. Both buildings stay on the map.
+     */
+    bool remove_path(const string& u, const string& v) {
+        return update_path(u, v, INF);
+    }
+
+    /**
+     * @brief Walkway changes made after revision `since`, oldest first. Returns false if the
+     * log does not reach back that far (or buildings were added), in which case everything
+     * cached before `since` must be dropped.
+     */
+    bool changes_since(uint64_t since, vector<PathChange>& changes) const {
+        changes.clear();
+        if (since < log_start_revision) {
+            return false;
+        }
+        for (const PathChange& change : change_log) {
+            if (change.revision > since) changes.push_back(change);
+        }
+        return true;
+    }
+
+    bool is_frozen() const { return frozen; }
+    uint64_t revision() const { return revision_number; }
+    const CSRGraph& compiled_graph() const { return compiled; }
+
     // Retrieves all nodes (buildings) in the map
     vector<string> get_nodes() const {
         vector<string> nodes;
+        if (adjacency_pending) {
+            for (uint32_t id = 0; id < compiled.nodeCount(); ++id) {
+                nodes.emplace_back(compiled.nameOf(id));
+            }
+            return nodes;
+        }
         for (const auto& pair : adj_list) {
             nodes.push_back(pair.first);
         }
         return nodes;
     }
 
+    bool has_node(const string& name) const {
+        if (adjacency_pending) {
+            return compiled.idOf(name) != NO_NODE;
+        }
+        return adj_list.find(name) != adj_list.end();
+    }
+
     double get_edge_weight(const string& u, const string& v) const {
+        if (adjacency_pending) {
+            uint32_t a = compiled.idOf(u), b = compiled.idOf(v);
+            uint32_t arc = a == NO_NODE || b == NO_NODE ? NO_NODE : compiled.findArc(a, b);
+            return arc == NO_NODE ? INF : compiled.arcWeight(arc);
+        }
+        double weight = INF; // No direct edge (or only closed ones)
         if (adj_list.find(u) != adj_list.end()) {
             for (const auto& edge : adj_list.at(u)) {
                 if (edge.first == v) {
-                    return edge.second;
+                    weight = min(weight, edge.second);
                 }
             }
         }
-        return INF; // No direct edge
+        return weight;
+    }
+
+    /**
+     * @brief Shortest route with the weight of every segment.
+     * Repeated queries are answered from the route cache. Otherwise, on a frozen map this uses
+     * the precomputed route table or contraction hierarchy if there is one, else A* (Dijkstra
+     * when buildings have no coordinates). Before freeze() it searches the adjacency map.
+     */
+    Route shortest_route(const string& start_node, const string& end_node) const {
+        MetricTimer timer(Metric::Route);
+        Route route;
+        auto still_valid = [this](const Route& cached, uint64_t since) { return route_survives(cached, since); };
+        if (route_cache.lookup(start_node, end_node, revision_number, route, still_valid)) {
+            timer.succeeded(route.found());
+            return route;
+        }
+        route = search_route(start_node, end_node);
+        route_cache.store(start_node, end_node, revision_number, route);
+        timer.succeeded(route.found());
+        return route;
+    }
+
+    // Hit/miss counters and size of the route cache
+    const RouteCache& route_cache_stats() const { return route_cache; }
+
+    // Number of routes kept (0 disables the cache)
+    void set_route_cache_capacity(size_t capacity) { route_cache.setCapacity(capacity); }
+
+    /**
+     * @brief Walking times from every building in `from` to every building in `to`, computed in
+     * parallel on the frozen map (see fill_distance_matrix). Unknown names give INF entries.
+     */
+    DistanceMatrix walking_times(const vector<string>& from, const vector<string>& to) const {
+        DistanceMatrix matrix(from, to);
+        if (!frozen) {
+            return matrix;
+        }
+        vector<uint32_t> sources, targets;
+        for (const string& name : from) sources.push_back(compiled.idOf(name));
+        for (const string& name : to) targets.push_back(compiled.idOf(name));
+        fill_distance_matrix(compiled, sources, targets, matrix);
+        return matrix;
+    }
+
+    /**
+     * @brief Visits buildings in increasing walking time from start_node on the frozen map.
+     * visit(name, minutes) returns true to stop. Returns false if the map is not frozen or
+     * start_node is unknown.
+     */
+    template <class Visit>
+    bool visit_by_distance(const string& start_node, Visit visit) const {
+        uint32_t source = frozen ? compiled.idOf(start_node) : NO_NODE;
+        if (source == NO_NODE) {
+            return false;
+        }
+        thread_local SearchScratch scratch;
+        compiled.explore(source, scratch, [this, &visit](uint32_t u, double d) {
+            return visit(string(compiled.nameOf(u)), d);
+        });
+        return true;
+    }
+
+    /**
+     * @brief A* search on the frozen map with a straight-line walking-time heuristic.
+     * Same result format as dijkstra_shortest_path; without coordinates it behaves like Dijkstra.
+     */
+    pair<vector<string>, double> astar_shortest_path(const string& start_node, const string& end_node) const {
+        if (!frozen) {
+            return dijkstra_on_adjacency(start_node, end_node);
+        }
+        thread_local SearchScratch scratch;
+        Route route = to_named_route(compiled.astarPath(compiled.idOf(start_node), compiled.idOf(end_node), scratch));
+        return {route.path, route.distance};
     }
 
     pair<vector<string>, double> dijkstra_shortest_path(const string& start_node, const string& end_node) const {
+        MetricTimer timer(Metric::ShortestPath);
+        if (!frozen) {
+            pair<vector<string>, double> result = dijkstra_on_adjacency(start_node, end_node);
+            timer.succeeded(!result.first.empty());
+            return result;
+        }
+        thread_local SearchScratch scratch;
+        Route route = to_named_route(compiled.shortestPath(compiled.idOf(start_node), compiled.idOf(end_node), scratch));
+        timer.succeeded(route.found());
+        return {route.path, route.distance};
+    }
+
+    // Dijkstra over the string-keyed adjacency map (used before freeze())
+    pair<vector<string>, double> dijkstra_on_adjacency(const string& start_node, const string& end_node) const {
+        if (adjacency_pending) {
+            return dijkstra_shortest_path(start_node, end_node);
+        }
         // Priority Queue: Min-heap to store {distance, vertex}
         // Use greater<> for min-heap on the first element (distance)
         priority_queue<WeightVertexPair, vector<WeightVertexPair>, greater<WeightVertexPair>> pq;
@@ -129,6 +667,21 @@ public:
      */
     void print_shortest_path(const string& start_node, const string& end_node,
                              const vector<string>& path, double final_distance) const {
+        Route route;
+        route.path = path;
+        route.distance = final_distance;
+        for (size_t i = 0; i + 1 < path.size(); ++i) {
+            route.segment_weights.push_back(get_edge_weight(path[i], path[i + 1]));
+        }
+        print_shortest_path(start_node, end_node, route);
+    }
+
+    /**
+     * @brief Prints a route using the segment weights it carries.
+     */
+    void print_shortest_path(const string& start_node, const string& end_node, const Route& route) const {
+        const vector<string>& path = route.path;
+        double final_distance = route.distance;
 
         if (final_distance == INF) {
             cout << "\n------------------------------------------------------------------\n";
@@ -153,8 +706,8 @@ public:
             const string& u = path[i];
             const string& v = path[i + 1];
 
-            // Get the distance for this segment using the graph object
-            double segment_weight = get_edge_weight(u, v);
+            // Segment weight carried by the route
+            double segment_weight = route.segment_weights[i];
             cumulative_distance += segment_weight;
 
             // Print the Edge (Walk)
@@ -0,0 +1,87 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/**
+ * @brief A whole file mapped into memory, copy-on-write: pages are read from disk only when
+ * touched, and writes stay private to this process. Where mmap is unavailable the file is
+ * read into an aligned buffer instead, with the same interface.
+ */
+class MappedFile {
+private:
+    char* bytes = nullptr;
+    size_t length = 0;
+    vector<uint64_t> buffer; // fallback storage (8-byte aligned)
+
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    bool open(const string& path) {
+        close();
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+        void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        ::close(fd); // the mapping keeps the file open
+        if (mapped == MAP_FAILED) {
+            return false;
+        }
+        bytes = static_cast<char*>(mapped);
+        length = static_cast<size_t>(info.st_size);
+        return true;
+#else
+        ifstream in(path, ios::binary | ios::ate);
+        if (!in.is_open()) {
+            return false;
+        }
+        size_t size = static_cast<size_t>(in.tellg());
+        buffer.assign((size + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+        in.seekg(0);
+        in.read(reinterpret_cast<char*>(buffer.data()), static_cast<streamsize>(size));
+        if (!in || size == 0) {
+            buffer.clear();
+            return false;
+        }
+        bytes = reinterpret_cast<char*>(buffer.data());
+        length = size;
+        return true;
+#endif
+    }
+
+    void close() {
+#ifndef _WIN32
+        if (bytes) munmap(bytes, length);
+#endif
+        buffer.clear();
+        bytes = nullptr;
+        length = 0;
+    }
+
+    char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+#endif // MAPPEDFILE_H
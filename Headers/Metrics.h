@@ -0,0 +1,291 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+
+#include "Trace.h"
+
+using namespace std;
+
+// The engine operations that are timed. Route is a route query as the menu and requests make it
+// (cache, route table, hierarchy or A*); ShortestPath is a plain Dijkstra search.
+enum class Metric { Login, BookSlot, CancelSlot, Route, ShortestPath, LoadUsers, LoadResources, SaveUsers, SaveResources, Count };
+
+const char* metric_name(Metric metric) {
+    static const char* names[] = {"login", "book_slot", "cancel_slot", "route", "shortest_path",
+                                  "load_users", "load_resources", "save_users", "save_resources"};
+    return names[static_cast<int>(metric)];
+}
+
+// The trace category of a metric's spans, matching the engine log's categories
+const char* metric_category(Metric metric) {
+    static const char* categories[] = {"users", "booking", "booking", "map", "map",
+                                       "storage", "storage", "storage", "storage"};
+    return categories[static_cast<int>(metric)];
+}
+
+const size_t METRIC_COUNT = static_cast<size_t>(Metric::Count);
+
+// Histogram layout (HDR style): values below 2^HISTOGRAM_SUB_BITS nanoseconds get a bucket each;
+// above that, every power of two is split into 2^HISTOGRAM_SUB_BITS buckets, so a bucket is
+// never wider than about 3% of its values. Values are capped at 2^41 ns (about 36 minutes).
+const int HISTOGRAM_SUB_BITS = 5;
+const int HISTOGRAM_MAX_EXPONENT = 40;
+const size_t HISTOGRAM_BUCKETS = static_cast<size_t>(HISTOGRAM_MAX_EXPONENT - HISTOGRAM_SUB_BITS + 2) << HISTOGRAM_SUB_BITS;
+
+size_t histogram_bucket(uint64_t ns) {
+    const uint64_t sub_count = uint64_t(1) << HISTOGRAM_SUB_BITS;
+    if (ns < sub_count) {
+        return static_cast<size_t>(ns);
+    }
+    ns = min(ns, (uint64_t(1) << (HISTOGRAM_MAX_EXPONENT + 1)) - 1);
+    int exponent = 63 - __builtin_clzll(ns);
+    int shift = exponent - HISTOGRAM_SUB_BITS;
+    return (static_cast<size_t>(shift + 1) << HISTOGRAM_SUB_BITS) + static_cast<size_t>((ns >> shift) - sub_count);
+}
+
+// Largest value (ns) that falls in a bucket
+uint64_t histogram_bucket_limit(size_t bucket) {
+    const size_t sub_count = size_t(1) << HISTOGRAM_SUB_BITS;
+    if (bucket < sub_count) {
+        return bucket;
+    }
+    int shift = static_cast<int>(bucket >> HISTOGRAM_SUB_BITS) - 1;
+    uint64_t lowest = static_cast<uint64_t>(sub_count + (bucket & (sub_count - 1))) << shift;
+    return lowest + (uint64_t(1) << shift) - 1;
+}
+
+/**
+ * @brief Merged measurements of one operation: a latency histogram plus totals.
+ */
+struct OperationStats {
+    vector<uint64_t> buckets = vector<uint64_t>(HISTOGRAM_BUCKETS, 0);
+    uint64_t count = 0;
+    uint64_t failures = 0;
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+
+    double meanNs() const { return count ? static_cast<double>(total_ns) / static_cast<double>(count) : 0.0; }
+
+    // Latency at quantile q (0-1): the upper edge of the bucket holding it
+    uint64_t quantileNs(double q) const {
+        if (count == 0) return 0;
+        uint64_t rank = max<uint64_t>(1, static_cast<uint64_t>(q * static_cast<double>(count) + 0.5));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            seen += buckets[i];
+            if (seen >= rank) return min(histogram_bucket_limit(i), max_ns);
+        }
+        return max_ns;
+    }
+
+    // Calls seen with a latency of at most `ns`
+    uint64_t countAtMost(uint64_t ns) const {
+        uint64_t seen = 0;
+        for (size_t i = 0; i < buckets.size() && histogram_bucket_limit(i) <= ns; ++i) {
+            seen += buckets[i];
+        }
+        return seen;
+    }
+};
+
+/**
+ * @brief Latency histograms and failure counts of the engine's main operations.
+ *
+ * Every thread records into its own shard, so recording is a couple of uncontended stores with
+ * no locks or shared cache lines; a snapshot adds the shards up. Shards outlive their threads
+ * so nothing recorded is lost. There is one instance, operation_metrics.
+ */
+class OperationMetrics {
+private:
+    struct Shard {
+        // Each shard has a single writer (its thread); snapshots read it concurrently
+        atomic<uint64_t> buckets[METRIC_COUNT][HISTOGRAM_BUCKETS];
+        atomic<uint64_t> failures[METRIC_COUNT];
+        atomic<uint64_t> total_ns[METRIC_COUNT];
+        atomic<uint64_t> max_ns[METRIC_COUNT];
+
+        Shard() {
+            for (size_t m = 0; m < METRIC_COUNT; ++m) {
+                for (atomic<uint64_t>& bucket : buckets[m]) bucket.store(0, memory_order_relaxed);
+                failures[m].store(0, memory_order_relaxed);
+                total_ns[m].store(0, memory_order_relaxed);
+                max_ns[m].store(0, memory_order_relaxed);
+            }
+        }
+    };
+
+    mutex shards_lock;
+    vector<unique_ptr<Shard>> shards;
+
+    Shard& localShard() {
+        thread_local Shard* shard = nullptr;
+        if (!shard) {
+            lock_guard<mutex> guard(shards_lock);
+            shards.push_back(make_unique<Shard>());
+            shard = shards.back().get();
+        }
+        return *shard;
+    }
+
+    static void bump(atomic<uint64_t>& value, uint64_t amount) {
+        value.store(value.load(memory_order_relaxed) + amount, memory_order_relaxed);
+    }
+
+public:
+    void record(Metric metric, uint64_t ns, bool ok) {
+        Shard& shard = localShard();
+        size_t m = static_cast<size_t>(metric);
+        bump(shard.buckets[m][histogram_bucket(ns)], 1);
+        bump(shard.total_ns[m], ns);
+        if (!ok) bump(shard.failures[m], 1);
+        if (ns > shard.max_ns[m].load(memory_order_relaxed)) shard.max_ns[m].store(ns, memory_order_relaxed);
+    }
+
+    // The merged measurements of every operation, indexed by Metric
+    vector<OperationStats> snapshot();
+
+    // Table of calls, failures and latency percentiles (the admin menu's view)
+    void printTable(ostream& out);
+    // {"operations":[{"op":...,"count":...,"p50_us":...,"buckets":[[limit_ns,count],...]},...]}
+    void writeJson(ostream& out);
+    // Prometheus text format: one histogram per operation plus failure counters
+    void writePrometheus(ostream& out);
+};
+
+// The engine's metrics
+OperationMetrics operation_metrics;
+
+/**
+ * @brief Times an operation from construction to destruction. Call fail() when it did not
+ * succeed (wrong password, slot taken, no path, ...). While tracing, the same interval is also
+ * recorded as a trace span named after the metric.
+ */
+class MetricTimer {
+private:
+    Metric metric;
+    chrono::steady_clock::time_point started;
+    bool ok = true;
+
+public:
+    explicit MetricTimer(Metric metric) : metric(metric), started(chrono::steady_clock::now()) {}
+    ~MetricTimer() {
+        auto finished = chrono::steady_clock::now();
+        auto elapsed = chrono::duration_cast<chrono::nanoseconds>(finished - started).count();
+        operation_metrics.record(metric, static_cast<uint64_t>(max<int64_t>(0, elapsed)), ok);
+        if (tracer.enabled()) {
+            tracer.record(metric_category(metric), metric_name(metric), started, finished, ok ? string() : "failed");
+        }
+    }
+    MetricTimer(const MetricTimer&) = delete;
+    MetricTimer& operator=(const MetricTimer&) = delete;
+
+    void fail() { ok = false; }
+    // Returns `success` so a result can be passed through
+    bool succeeded(bool success) {
+        ok = success;
+        return success;
+    }
+};
+
+vector<OperationStats> OperationMetrics::snapshot() {
+    vector<OperationStats> stats(METRIC_COUNT);
+    lock_guard<mutex> guard(shards_lock);
+    for (const auto& shard : shards) {
+        for (size_t m = 0; m < METRIC_COUNT; ++m) {
+            OperationStats& op = stats[m];
+            for (size_t b = 0; b < HISTOGRAM_BUCKETS; ++b) {
+                uint64_t n = shard->buckets[m][b].load(memory_order_relaxed);
+                op.buckets[b] += n;
+                op.count += n;
+            }
+            op.failures += shard->failures[m].load(memory_order_relaxed);
+            op.total_ns += shard->total_ns[m].load(memory_order_relaxed);
+            op.max_ns = max(op.max_ns, shard->max_ns[m].load(memory_order_relaxed));
+        }
+    }
+    return stats;
+}
+
+void OperationMetrics::printTable(ostream& out) {
+    vector<OperationStats> stats = snapshot();
+    out << "\n" << left << setw(16) << "Operation" << right << setw(10) << "Calls" << setw(10) << "Failed"
+        << setw(11) << "Mean us" << setw(11) << "p50 us" << setw(11) << "p90 us" << setw(11) << "p99 us"
+        << setw(11) << "Max us" << "\n";
+    out << fixed << setprecision(1);
+    for (size_t m = 0; m < METRIC_COUNT; ++m) {
+        const OperationStats& op = stats[m];
+        out << left << setw(16) << metric_name(static_cast<Metric>(m)) << right << setw(10) << op.count
+            << setw(10) << op.failures << setw(11) << op.meanNs() / 1000.0 << setw(11) << op.quantileNs(0.50) / 1000.0
+            << setw(11) << op.quantileNs(0.90) / 1000.0 << setw(11) << op.quantileNs(0.99) / 1000.0
+            << setw(11) << op.max_ns / 1000.0 << "\n";
+    }
+    out << defaultfloat;
+}
+
+void OperationMetrics::writeJson(ostream& out) {
+    vector<OperationStats> stats = snapshot();
+    char number[32];
+    auto micros = [&number](double ns) {
+        snprintf(number, sizeof(number), "%.3f", ns / 1000.0);
+        return string(number);
+    };
+    out << "{\"operations\":[";
+    for (size_t m = 0; m < METRIC_COUNT; ++m) {
+        const OperationStats& op = stats[m];
+        out << (m ? "," : "") << "{\"op\":\"" << metric_name(static_cast<Metric>(m)) << "\",\"count\":" << op.count
+            << ",\"failures\":" << op.failures << ",\"mean_us\":" << micros(op.meanNs())
+            << ",\"p50_us\":" << micros(static_cast<double>(op.quantileNs(0.50)))
+            << ",\"p90_us\":" << micros(static_cast<double>(op.quantileNs(0.90)))
+            << ",\"p99_us\":" << micros(static_cast<double>(op.quantileNs(0.99)))
+            << ",\"p999_us\":" << micros(static_cast<double>(op.quantileNs(0.999)))
+            << ",\"max_us\":" << micros(static_cast<double>(op.max_ns)) << ",\"buckets\":[";
+        // Only the buckets in use, as [upper limit in ns, count]
+        bool first = true;
+        for (size_t b = 0; b < HISTOGRAM_BUCKETS; ++b) {
+            if (op.buckets[b] == 0) continue;
+            out << (first ? "" : ",") << "[" << histogram_bucket_limit(b) << "," << op.buckets[b] << "]";
+            first = false;
+        }
+        out << "]}";
+    }
+    out << "]}\n";
+}
+
+void OperationMetrics::writePrometheus(ostream& out) {
+    // Bucket bounds in seconds; each count is exact for the histogram buckets at or below the bound
+    static const double bounds[] = {1e-6, 2.5e-6, 5e-6, 1e-5, 2.5e-5, 5e-5, 1e-4, 2.5e-4, 5e-4,
+                                    1e-3, 2.5e-3, 5e-3, 1e-2, 2.5e-2, 5e-2, 0.1, 0.25, 0.5, 1, 2.5, 5, 10};
+    vector<OperationStats> stats = snapshot();
+    out << "# HELP nul_operation_duration_seconds Time taken by engine operations.\n";
+    out << "# TYPE nul_operation_duration_seconds histogram\n";
+    for (size_t m = 0; m < METRIC_COUNT; ++m) {
+        const OperationStats& op = stats[m];
+        string label = string("{op=\"") + metric_name(static_cast<Metric>(m)) + "\"";
+        for (double bound : bounds) {
+            out << "nul_operation_duration_seconds_bucket" << label << ",le=\"" << bound << "\"} "
+                << op.countAtMost(static_cast<uint64_t>(bound * 1e9)) << "\n";
+        }
+        out << "nul_operation_duration_seconds_bucket" << label << ",le=\"+Inf\"} " << op.count << "\n";
+        out << "nul_operation_duration_seconds_sum" << label << "} " << static_cast<double>(op.total_ns) / 1e9 << "\n";
+        out << "nul_operation_duration_seconds_count" << label << "} " << op.count << "\n";
+    }
+    out << "# HELP nul_operation_failures_total Engine operations that did not succeed.\n";
+    out << "# TYPE nul_operation_failures_total counter\n";
+    for (size_t m = 0; m < METRIC_COUNT; ++m) {
+        out << "nul_operation_failures_total{op=\"" << metric_name(static_cast<Metric>(m)) << "\"} "
+            << stats[m].failures << "\n";
+    }
+}
+
+#endif // METRICS_H
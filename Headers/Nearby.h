@@ -0,0 +1,76 @@
+#ifndef NEARBY_H
+#define NEARBY_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+
+#include "Resource.h"
+#include "Lab.h"
+#include "Map.h"
+#include "Engine.h"
+
+using namespace std;
+
+/**
+ * @brief A free resource found by nearest_free_resources, with the walk to its building.
+ */
+struct NearbyResource {
+    Resource* resource;
+    double minutes;
+};
+
+/**
+ * @brief Index of resources by the building (map node) they are located in.
+ */
+class ResourceLocator {
+private:
+    unordered_map<string, vector<Resource*>> by_building;
+
+public:
+    explicit ResourceLocator(const map<int, Resource*>& resources) { rebuild(resources); }
+
+    // Re-indexes all resources (after loading or adding resources)
+    void rebuild(const map<int, Resource*>& resources) {
+        by_building.clear();
+        for (const auto& pair : resources) {
+            by_building[pair.second->getLocation().getName()].push_back(pair.second);
+        }
+    }
+
+    const vector<Resource*>* in(const string& building) const {
+        auto it = by_building.find(building);
+        return it == by_building.end() ? nullptr : &it->second;
+    }
+};
+
+/**
+ * @brief The k nearest available slotted resources that are free in slot_id, nearest first.
+ * Walks the buildings in order of walking time from `from` (one search) and stops as soon as k
+ * resources are found. type limits the search to "LAB" or "LECTUREHALL"; empty means both.
+ */
+vector<NearbyResource> nearest_free_resources(const NULMapGraph& campus_map, const ResourceLocator& locator,
+                                              const string& from, int slot_id, size_t k, const string& type = "") {
+    vector<NearbyResource> found;
+    if (k == 0) {
+        return found;
+    }
+    campus_map.visit_by_distance(from, [&](const string& building, double minutes) {
+        const vector<Resource*>* here = locator.in(building);
+        if (here) {
+            for (Resource* resource : *here) {
+                if (!is_slotted(resource) || !resource->getAvailability()) continue;
+                if (!type.empty() && resource->getType() != type) continue;
+                if (dynamic_cast<Lab*>(resource)->isSlotFree(slot_id)) {
+                    found.push_back({resource, minutes});
+                    if (found.size() == k) return true;
+                }
+            }
+        }
+        return false;
+    });
+    return found;
+}
+
+#endif // NEARBY_H
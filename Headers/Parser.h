@@ -0,0 +1,136 @@
+#ifndef PARSER_H
+#define PARSER_H
+
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <charconv>
+
+using namespace std;
+
+/**
+ * @brief Splits a string_view on a single delimiter without copying.
+ * Usage: FieldSplitter f(line, '|'); string_view part; while (f.next(part)) { ... }
+ * Mirrors getline(ss, segment, delim): a trailing delimiter does not yield an extra empty field.
+ */
+class FieldSplitter {
+private:
+    string_view text;
+    size_t pos;
+    char delim;
+
+public:
+    FieldSplitter(string_view text, char delim) : text(text), pos(0), delim(delim) {}
+
+    bool next(string_view& field) {
+        if (pos >= text.size()) {
+            return false;
+        }
+        size_t end = text.find(delim, pos);
+        if (end == string_view::npos) {
+            end = text.size();
+        }
+        field = text.substr(pos, end - pos);
+        pos = end + 1;
+        return true;
+    }
+};
+
+/**
+ * @brief Splits a line into at most `max_fields` fields. Returns the number of fields found
+ * (which may exceed max_fields; the extra fields are counted but not stored).
+ */
+size_t split_fields(string_view line, char delim, string_view* fields, size_t max_fields) {
+    FieldSplitter splitter(line, delim);
+    string_view field;
+    size_t count = 0;
+    while (splitter.next(field)) {
+        if (count < max_fields) {
+            fields[count] = field;
+        }
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Converts a field to an int with std::from_chars. Returns false unless the whole field is a number.
+ */
+bool parse_int(string_view field, int& value) {
+    const char* first = field.data();
+    const char* last = field.data() + field.size();
+    auto result = from_chars(first, last, value);
+    return result.ec == errc() && result.ptr == last;
+}
+
+/**
+ * @brief Converts a field to a double with std::from_chars. Returns false unless the whole field is a number.
+ */
+bool parse_double(string_view field, double& value) {
+    const char* first = field.data();
+    const char* last = field.data() + field.size();
+    auto result = from_chars(first, last, value);
+    return result.ec == errc() && result.ptr == last;
+}
+
+/**
+ * @brief Returns the part of a "Label:data" field after the first ':' (the whole field if there is none).
+ */
+string_view after_label(string_view field) {
+    size_t colon = field.find(':');
+    return colon == string_view::npos ? field : field.substr(colon + 1);
+}
+
+/**
+ * @brief Reads a whole file into a single buffer. Returns false if the file cannot be opened.
+ */
+bool read_file_buffer(const string& path, string& buffer) {
+    ifstream infile(path, ios::binary);
+    if (!infile.is_open()) {
+        return false;
+    }
+    infile.seekg(0, ios::end);
+    streamoff length = infile.tellg();
+    infile.seekg(0, ios::beg);
+    buffer.resize(length > 0 ? static_cast<size_t>(length) : 0);
+    if (!buffer.empty()) {
+        infile.read(&buffer[0], static_cast<streamsize>(buffer.size()));
+        buffer.resize(static_cast<size_t>(infile.gcount()));
+    }
+    return true;
+}
+
+/**
+ * @brief Iterates over the lines of a buffer as string_views, tracking the 1-based line number.
+ * Handles both "\n" and "\r\n" line endings.
+ */
+class LineReader {
+private:
+    string_view text;
+    size_t pos;
+    int line_number;
+
+public:
+    LineReader(string_view text, int first_line = 1) : text(text), pos(0), line_number(first_line - 1) {}
+
+    bool next(string_view& line) {
+        if (pos >= text.size()) {
+            return false;
+        }
+        size_t end = text.find('\n', pos);
+        if (end == string_view::npos) {
+            end = text.size();
+        }
+        line = text.substr(pos, end - pos);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        pos = end + 1;
+        line_number++;
+        return true;
+    }
+
+    int lineNumber() const { return line_number; }
+};
+
+#endif // PARSER_H
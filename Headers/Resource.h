@@ -3,12 +3,19 @@
 
 #include <string>
 #include "Location.h"
+#include "ChangeTracker.h"
 
 using namespace std;
 
 struct Location {
     string name;
+    // Planar position in metres (same frame as the campus map); only meaningful if hasCoordinates
+    double x = 0.0;
+    double y = 0.0;
+    bool hasCoordinates = false;
+
     Location(string n = "Unknown") : name(n) {}
+    Location(string n, double x, double y) : name(n), x(x), y(y), hasCoordinates(true) {}
     string getName() const { return name; }
 };
 // ----------------------------------------------------------------------------
@@ -20,6 +27,7 @@ class Resource{
         string type;
         Location location;
         bool isAvailable;
+        bool dirty = false; // changed since the last save
 
     public:
         //setters
@@ -36,17 +44,22 @@ class Resource{
 
         //availability
         bool getAvailability() const;
-        void setAvailability(bool availability);\
+        void setAvailability(bool availability);
+
+        //change tracking (see save_resources)
+        void markDirty();
+        bool isDirty() const { return dirty; }
+        void clearDirty() { dirty = false; }
 
         virtual ~Resource() {}
 
 };
 
 // Setters
-void Resource::setId(int id) { this->id = id; }
-void Resource::setName(const string& name) { this->name = name; }
-void Resource::setType(const string& type) { this->type = type; }
-void Resource::setLocation(const Location& location) { this->location = location; }
+void Resource::setId(int id) { this->id = id; dirty = true; resource_changes().record(id); }
+void Resource::setName(const string& name) { this->name = name; markDirty(); }
+void Resource::setType(const string& type) { this->type = type; markDirty(); }
+void Resource::setLocation(const Location& location) { this->location = location; markDirty(); }
 
 // Getters
 int Resource::getId() const { return id; }
@@ -56,7 +69,15 @@ Location Resource::getLocation() const { return location; }
 
 // Availability
 bool Resource::getAvailability() const { return isAvailable; }
-void Resource::setAvailability(bool availability) { isAvailable = availability; }
+void Resource::setAvailability(bool availability) { isAvailable = availability; markDirty(); }
+
+// Change tracking: report the id once per clean -> dirty transition
+void Resource::markDirty() {
+    if (!dirty) {
+        dirty = true;
+        resource_changes().record(id);
+    }
+}
 
 
 #endif // RESOURCE_H
@@ -0,0 +1,129 @@
+#ifndef ROUTECACHE_H
+#define ROUTECACHE_H
+
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+
+#include "CSRGraph.h"
+
+using namespace std;
+
+// Routes kept by default; students ask for the same few hundred pairs over and over
+const size_t DEFAULT_ROUTE_CACHE_CAPACITY = 1024;
+
+/**
+ * @brief Least-recently-used cache of routes keyed on (start, end).
+ *
+ * Every entry is tagged with the map generation (revision) it was computed at. A lookup at a
+ * newer generation asks the caller whether the entry survived the edits in between; entries that
+ * did not are dropped, so a stale route is never returned. A hit costs one hash lookup and a
+ * list splice. Safe to use from several threads.
+ */
+class RouteCache {
+private:
+    struct Entry {
+        string key;
+        uint64_t generation;
+        BasicRoute<string> route;
+    };
+
+    size_t max_entries;
+    list<Entry> entries; // most recently used first
+    unordered_map<string, list<Entry>::iterator> index;
+    mutable mutex lock;
+    atomic<uint64_t> hit_count{0};
+    atomic<uint64_t> miss_count{0};
+
+    static string makeKey(const string& from, const string& to) {
+        string key;
+        key.reserve(from.size() + to.size() + 1);
+        key += from;
+        key += '\0';
+        key += to;
+        return key;
+    }
+
+public:
+    explicit RouteCache(size_t capacity = DEFAULT_ROUTE_CACHE_CAPACITY) : max_entries(capacity) {}
+
+    /**
+     * @brief Copies the cached route for (from, to) into `route` and returns true on a hit.
+     * An entry from an older generation is kept only if still_valid(route, its_generation)
+     * says so, and is then re-tagged with `generation`.
+     */
+    template <class StillValid>
+    bool lookup(const string& from, const string& to, uint64_t generation, BasicRoute<string>& route, StillValid still_valid) {
+        lock_guard<mutex> guard(lock);
+        auto it = index.find(makeKey(from, to));
+        if (it == index.end()) {
+            miss_count++;
+            return false;
+        }
+        Entry& entry = *it->second;
+        if (entry.generation != generation) {
+            if (!still_valid(entry.route, entry.generation)) {
+                entries.erase(it->second);
+                index.erase(it);
+                miss_count++;
+                return false;
+            }
+            entry.generation = generation;
+        }
+        entries.splice(entries.begin(), entries, it->second);
+        route = entry.route;
+        hit_count++;
+        return true;
+    }
+
+    // Stores a route computed at `generation`, evicting the least recently used entry if full
+    void store(const string& from, const string& to, uint64_t generation, const BasicRoute<string>& route) {
+        if (max_entries == 0) {
+            return;
+        }
+        string key = makeKey(from, to);
+        lock_guard<mutex> guard(lock);
+        auto it = index.find(key);
+        if (it != index.end()) {
+            it->second->generation = generation;
+            it->second->route = route;
+            entries.splice(entries.begin(), entries, it->second);
+            return;
+        }
+        if (entries.size() >= max_entries) {
+            index.erase(entries.back().key);
+            entries.pop_back();
+        }
+        entries.push_front({key, generation, route});
+        index.emplace(move(key), entries.begin());
+    }
+
+    void clear() {
+        lock_guard<mutex> guard(lock);
+        entries.clear();
+        index.clear();
+    }
+
+    // Changes the capacity (0 disables caching), evicting the oldest entries if needed
+    void setCapacity(size_t capacity) {
+        lock_guard<mutex> guard(lock);
+        max_entries = capacity;
+        while (entries.size() > max_entries) {
+            index.erase(entries.back().key);
+            entries.pop_back();
+        }
+    }
+
+    size_t capacity() const { return max_entries; }
+    size_t size() const {
+        lock_guard<mutex> guard(lock);
+        return entries.size();
+    }
+    uint64_t hits() const { return hit_count; }
+    uint64_t misses() const { return miss_count; }
+};
+
+#endif // ROUTECACHE_H
@@ -0,0 +1,303 @@
+#ifndef ROUTETABLE_H
+#define ROUTETABLE_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+
+#include "CSRGraph.h"
+#include "ThreadPool.h"
+#include "Trace.h"
+
+using namespace std;
+
+/**
+ * @brief A change of one arc's weight (INF = closed / not present).
+ */
+struct ArcChange {
+    uint32_t from;
+    uint32_t to;
+    double old_weight;
+    double new_weight;
+};
+
+// Above this many nodes the table is not built and routes are searched on demand
+const size_t DEFAULT_ROUTE_TABLE_MAX_NODES = 2048;
+
+/**
+ * @brief Precomputed all-pairs routes for a CSRGraph.
+ * For every (source, target) pair it stores the walking distance (as float) and the first arc of
+ * a shortest route. A query follows first arcs hop by hop, so no search is run at query time.
+ */
+class RouteTable {
+private:
+    size_t n = 0;
+    uint64_t graph_fingerprint = 0;
+    vector<float> dist;         // n x n, row = source
+    vector<uint32_t> first_arc; // n x n, NO_NODE when unreachable or source == target
+
+    void buildRow(const CSRGraph& graph, uint32_t source, SearchScratch& scratch);
+
+public:
+    // Runs one full Dijkstra per node on the shared thread pool
+    void build(const CSRGraph& graph);
+
+    // Binary cache; load() fails if the file was built for a different graph
+    bool save(const string& path) const;
+    bool load(const string& path, const CSRGraph& graph);
+
+    bool builtFor(const CSRGraph& graph) const { return n == graph.nodeCount() && graph_fingerprint == graph.fingerprint(); }
+    size_t nodeCount() const { return n; }
+    size_t memoryBytes() const { return dist.size() * sizeof(float) + first_arc.size() * sizeof(uint32_t); }
+
+    double distance(uint32_t source, uint32_t target) const {
+        float d = dist[static_cast<size_t>(source) * n + target];
+        return d == numeric_limits<float>::infinity() ? INF : d;
+    }
+
+    /**
+     * @brief Route by walking first arcs from source to target. Rows are separate shortest-path
+     * trees, so with tied (e.g. zero-minute) walkways two rows can point at each other; a walk
+     * longer than n hops is abandoned and the route is searched instead.
+     */
+    NodeRoute route(const CSRGraph& graph, uint32_t source, uint32_t target) const;
+
+    /**
+     * @brief Brings the table up to date after arc weights changed in graph (already applied),
+     * without rebuilding it. In every row, a slower or closed arc only invalidates the nodes
+     * whose shortest route used it; those are re-reached from the rest of the tree. A faster
+     * arc only touches the nodes it now gets closer. Returns the number of rows that changed.
+     */
+    size_t repair(const CSRGraph& graph, const vector<ArcChange>& changes);
+};
+
+void RouteTable::buildRow(const CSRGraph& graph, uint32_t source, SearchScratch& scratch) {
+    graph.search(source, NO_NODE, scratch);
+    float* dist_row = &dist[static_cast<size_t>(source) * n];
+    uint32_t* arc_row = &first_arc[static_cast<size_t>(source) * n];
+    fill(arc_row, arc_row + n, NO_NODE);
+
+    // first arc of v = the arc leaving source on v's predecessor chain. Walk each chain up to the
+    // first node whose first arc is already known, then fill the chain on the way back.
+    vector<uint32_t> chain;
+    for (uint32_t v = 0; v < n; ++v) {
+        dist_row[v] = static_cast<float>(scratch.distance(v));
+        if (v == source || !scratch.reached(v) || arc_row[v] != NO_NODE) continue;
+
+        chain.clear();
+        uint32_t u = v;
+        while (arc_row[u] == NO_NODE && scratch.predecessor(u) != source) {
+            chain.push_back(u);
+            u = scratch.predecessor(u);
+        }
+        uint32_t arc = (arc_row[u] != NO_NODE) ? arc_row[u] : scratch.predecessorArc(u);
+        arc_row[u] = arc;
+        for (uint32_t w : chain) {
+            arc_row[w] = arc;
+        }
+    }
+}
+
+void RouteTable::build(const CSRGraph& graph) {
+    n = graph.nodeCount();
+    graph_fingerprint = graph.fingerprint();
+    dist.assign(n * n, numeric_limits<float>::infinity());
+    first_arc.assign(n * n, NO_NODE);
+
+    // Rows are independent; the graph is only read
+    parallel_for(shared_thread_pool(), n, [this, &graph](size_t begin, size_t end) {
+        TraceSpan span("map", "route_table_rows");
+        SearchScratch scratch;
+        for (size_t s = begin; s < end; ++s) {
+            buildRow(graph, static_cast<uint32_t>(s), scratch);
+        }
+    });
+}
+
+size_t RouteTable::repair(const CSRGraph& graph, const vector<ArcChange>& changes) {
+    const float FLOAT_INF = numeric_limits<float>::infinity();
+    vector<ArcChange> slower, faster;
+    for (const ArcChange& change : changes) {
+        (change.new_weight > change.old_weight ? slower : faster).push_back(change);
+    }
+
+    // Arcs entering each node (the CSR only lists arcs leaving a node)
+    vector<uint32_t> in_offsets(n + 1, 0), in_arcs(graph.arcCount()), in_sources(graph.arcCount());
+    for (uint32_t u = 0; u < n; ++u) {
+        for (uint32_t arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) in_offsets[graph.arcTarget(arc) + 1]++;
+    }
+    for (size_t i = 0; i < n; ++i) in_offsets[i + 1] += in_offsets[i];
+    vector<uint32_t> next(in_offsets.begin(), in_offsets.end() - 1);
+    for (uint32_t u = 0; u < n; ++u) {
+        for (uint32_t arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+            uint32_t slot = next[graph.arcTarget(arc)]++;
+            in_arcs[slot] = arc;
+            in_sources[slot] = u;
+        }
+    }
+
+    // Old distances from the head of every slower arc, copied before any row changes
+    vector<vector<float>> head_rows;
+    for (const ArcChange& change : slower) {
+        const float* row = &dist[static_cast<size_t>(change.to) * n];
+        head_rows.emplace_back(row, row + n);
+    }
+
+    size_t repaired_rows = 0;
+    mutex count_mutex;
+    graph_fingerprint = graph.fingerprint();
+    parallel_for(shared_thread_pool(), n, [&](size_t begin, size_t end) {
+        SearchScratch scratch;
+        vector<uint32_t> affected;
+        vector<char> in_affected(n, 0);
+        size_t local_repaired = 0;
+        for (uint32_t s = static_cast<uint32_t>(begin); s < end; ++s) {
+            float* dist_row = &dist[static_cast<size_t>(s) * n];
+            uint32_t* arc_row = &first_arc[static_cast<size_t>(s) * n];
+            auto first_arc_via = [&](uint32_t from, uint32_t arc) { return from == s ? arc : arc_row[from]; };
+            bool changed = false;
+
+            // 1. Slower or closed arcs: the nodes that had a shortest route through one of them
+            //    lose their distance and are re-reached from the unaffected part of the tree
+            affected.clear();
+            for (size_t c = 0; c < slower.size(); ++c) {
+                double d_from = dist_row[slower[c].from];
+                if (d_from == FLOAT_INF) continue;
+                for (uint32_t x = 0; x < n; ++x) {
+                    if (in_affected[x] || dist_row[x] == FLOAT_INF || head_rows[c][x] == FLOAT_INF) continue;
+                    double via = d_from + slower[c].old_weight + head_rows[c][x];
+                    if (via <= dist_row[x] + 1e-5 * max(1.0, static_cast<double>(dist_row[x]))) {
+                        in_affected[x] = 1;
+                        affected.push_back(x);
+                    }
+                }
+            }
+            if (!affected.empty()) {
+                changed = true;
+                scratch.reset(n);
+                for (uint32_t x : affected) {
+                    for (uint32_t i = in_offsets[x]; i < in_offsets[x + 1]; ++i) {
+                        uint32_t y = in_sources[i];
+                        double w = graph.arcWeight(in_arcs[i]);
+                        if (in_affected[y] || w == INF || dist_row[y] == FLOAT_INF) continue;
+                        scratch.relax(x, dist_row[y] + w, y, first_arc_via(y, in_arcs[i]));
+                    }
+                }
+                while (!scratch.empty()) {
+                    uint32_t x = scratch.pop();
+                    double d_x = scratch.distance(x);
+                    for (uint32_t arc = graph.arcBegin(x); arc < graph.arcEnd(x); ++arc) {
+                        uint32_t z = graph.arcTarget(arc);
+                        if (in_affected[z] && graph.arcWeight(arc) != INF) {
+                            scratch.relax(z, d_x + graph.arcWeight(arc), x, scratch.predecessorArc(x));
+                        }
+                    }
+                }
+                for (uint32_t x : affected) {
+                    dist_row[x] = static_cast<float>(scratch.distance(x));
+                    arc_row[x] = scratch.predecessorArc(x);
+                    in_affected[x] = 0;
+                }
+            }
+
+            // 2. Faster arcs: improvements spread out from their heads
+            scratch.reset(n);
+            for (const ArcChange& change : faster) {
+                if (dist_row[change.from] == FLOAT_INF) continue;
+                double d = dist_row[change.from] + change.new_weight;
+                if (d < dist_row[change.to] - 1e-6 * max(1.0, d)) {
+                    scratch.relax(change.to, d, change.from, first_arc_via(change.from, graph.findArc(change.from, change.to)));
+                }
+            }
+            while (!scratch.empty()) {
+                changed = true;
+                uint32_t x = scratch.pop();
+                double d_x = scratch.distance(x);
+                dist_row[x] = static_cast<float>(d_x);
+                arc_row[x] = scratch.predecessorArc(x);
+                for (uint32_t arc = graph.arcBegin(x); arc < graph.arcEnd(x); ++arc) {
+                    uint32_t z = graph.arcTarget(arc);
+                    double d = d_x + graph.arcWeight(arc);
+                    if (z != s && !scratch.settled(z) && d < dist_row[z] - 1e-6 * max(1.0, d)) {
+                        scratch.relax(z, d, x, arc_row[x]);
+                    }
+                }
+            }
+            if (changed) local_repaired++;
+        }
+        lock_guard<mutex> lock(count_mutex);
+        repaired_rows += local_repaired;
+    }, 16);
+    return repaired_rows;
+}
+
+NodeRoute RouteTable::route(const CSRGraph& graph, uint32_t source, uint32_t target) const {
+    NodeRoute result;
+    if (source >= n || target >= n || distance(source, target) == INF) {
+        return result;
+    }
+    result.distance = 0.0;
+    result.path.push_back(source);
+    for (uint32_t u = source; u != target; ) {
+        if (result.segment_weights.size() >= n) {
+            thread_local SearchScratch scratch;
+            return graph.shortestPath(source, target, scratch);
+        }
+        uint32_t arc = first_arc[static_cast<size_t>(u) * n + target];
+        double weight = graph.arcWeight(arc);
+        u = graph.arcTarget(arc);
+        result.path.push_back(u);
+        result.segment_weights.push_back(weight);
+        result.distance += weight;
+    }
+    return result;
+}
+
+const char ROUTE_TABLE_MAGIC[8] = {'N', 'U', 'L', 'R', 'T', 'B', 'L', '1'};
+
+bool RouteTable::save(const string& path) const {
+    ofstream out(path, ios::binary);
+    if (!out.is_open()) {
+        return false;
+    }
+    uint64_t header[2] = {static_cast<uint64_t>(n), graph_fingerprint};
+    out.write(ROUTE_TABLE_MAGIC, sizeof(ROUTE_TABLE_MAGIC));
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(dist.data()), static_cast<streamsize>(dist.size() * sizeof(float)));
+    out.write(reinterpret_cast<const char*>(first_arc.data()), static_cast<streamsize>(first_arc.size() * sizeof(uint32_t)));
+    return static_cast<bool>(out);
+}
+
+bool RouteTable::load(const string& path, const CSRGraph& graph) {
+    ifstream in(path, ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    char magic[sizeof(ROUTE_TABLE_MAGIC)];
+    uint64_t header[2];
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!in || memcmp(magic, ROUTE_TABLE_MAGIC, sizeof(magic)) != 0
+        || header[0] != graph.nodeCount() || header[1] != graph.fingerprint()) {
+        return false;
+    }
+
+    size_t count = static_cast<size_t>(header[0]) * static_cast<size_t>(header[0]);
+    vector<float> loaded_dist(count);
+    vector<uint32_t> loaded_arcs(count);
+    in.read(reinterpret_cast<char*>(loaded_dist.data()), static_cast<streamsize>(count * sizeof(float)));
+    in.read(reinterpret_cast<char*>(loaded_arcs.data()), static_cast<streamsize>(count * sizeof(uint32_t)));
+    if (!in) {
+        return false;
+    }
+    n = static_cast<size_t>(header[0]);
+    graph_fingerprint = header[1];
+    dist.swap(loaded_dist);
+    first_arc.swap(loaded_arcs);
+    return true;
+}
+
+#endif // ROUTETABLE_H
@@ -0,0 +1,380 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+// Server mode uses epoll and Unix-domain sockets, so it is only built on Linux
+#ifdef __linux__
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Batch.h"
+#include "ThreadPool.h"
+
+using namespace std;
+
+// Requests longer than this close the connection (protects the input buffers)
+const size_t MAX_REQUEST_LINE = 64 * 1024;
+
+/**
+ * @brief Serves JSON-lines requests (the batch format, see BatchProcessor) over a Unix-domain
+ * socket, one result line per request line.
+ *
+ * One thread runs an epoll loop that accepts clients, reads their bytes and writes results back;
+ * it never runs a request itself. Complete request lines are handed to a worker pool. A
+ * connection has at most one worker task at a time, so its requests run and answer in order,
+ * while different connections run in parallel: read-only ops (route, journey, seats, list)
+ * share the engine lock, everything else takes it exclusively. Each connection has its own
+ * logged-in users, replacing the menu's single global currentUser.
+ */
+class RequestServer {
+private:
+    struct Connection {
+        int fd;
+        string input;           // bytes read but not yet split into lines (loop thread only)
+        bool peer_closed = false;
+        bool want_write = false; // EPOLLOUT registered (loop thread only)
+
+        mutex lock;             // guards the fields below
+        deque<string> pending;  // request lines waiting for a worker
+        string output;          // results waiting to be written
+        bool busy = false;      // a worker task owns this connection's requests
+
+        SessionTable sessions;  // touched only by the connection's worker task
+        int line = 0;
+
+        explicit Connection(int fd) : fd(fd) {}
+    };
+
+    BatchProcessor& processor;
+    unique_ptr<ThreadPool> workers;
+    shared_mutex engine_lock;
+
+    int listen_fd = -1;
+    int epoll_fd = -1;
+    int wake_fd = -1; // eventfd: workers signal finished results, stop() signals shutdown
+    string socket_path;
+    atomic<bool> stopping{false};
+
+    map<int, shared_ptr<Connection>> connections;
+    mutex finished_lock;
+    vector<shared_ptr<Connection>> finished; // connections with new output
+
+    void acceptClients();
+    void readClient(const shared_ptr<Connection>& conn);
+    void writeClient(const shared_ptr<Connection>& conn);
+    void closeClient(const shared_ptr<Connection>& conn);
+    void schedule(const shared_ptr<Connection>& conn);
+    void work(const shared_ptr<Connection>& conn);
+    void notify(const shared_ptr<Connection>& conn);
+    void setWriteInterest(const shared_ptr<Connection>& conn, bool want);
+
+public:
+    RequestServer(BatchProcessor& processor, size_t worker_count) : processor(processor), workers(make_unique<ThreadPool>(worker_count)) {}
+    ~RequestServer();
+
+    RequestServer(const RequestServer&) = delete;
+    RequestServer& operator=(const RequestServer&) = delete;
+
+    // Binds and listens on a Unix-domain socket (an old socket file is replaced)
+    bool listen(const string& path);
+
+    // Runs the event loop until stop() is called. Returns false if listen() was not called.
+    bool run();
+
+    // Asks run() to return; safe to call from any thread or a signal handler
+    void stop();
+
+    size_t workerCount() const { return workers->size(); }
+};
+
+RequestServer::~RequestServer() {
+    workers.reset(); // finish queued requests before their connections and the eventfd go away
+    for (auto& entry : connections) {
+        close(entry.first);
+    }
+    if (listen_fd >= 0) {
+        close(listen_fd);
+        unlink(socket_path.c_str());
+    }
+    if (epoll_fd >= 0) close(epoll_fd);
+    if (wake_fd >= 0) close(wake_fd);
+}
+
+bool RequestServer::listen(const string& path) {
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    unlink(path.c_str());
+
+    listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0 || bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(listen_fd, SOMAXCONN) != 0) {
+        return false;
+    }
+    socket_path = path;
+
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd < 0 || wake_fd < 0) {
+        return false;
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = listen_fd;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &event);
+    event.data.fd = wake_fd;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &event);
+    return true;
+}
+
+void RequestServer::stop() {
+    stopping = true;
+    uint64_t one = 1;
+    if (wake_fd >= 0 && write(wake_fd, &one, sizeof(one)) < 0) {
+        // The loop is already being woken; nothing else to do
+    }
+}
+
+bool RequestServer::run() {
+    if (epoll_fd < 0) {
+        return false;
+    }
+    vector<epoll_event> events(256);
+    while (!stopping) {
+        int count = epoll_wait(epoll_fd, events.data(), static_cast<int>(events.size()), -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == listen_fd) {
+                acceptClients();
+                continue;
+            }
+            if (fd == wake_fd) {
+                uint64_t ignored;
+                while (read(wake_fd, &ignored, sizeof(ignored)) > 0) {}
+                vector<shared_ptr<Connection>> ready;
+                {
+                    lock_guard<mutex> guard(finished_lock);
+                    ready.swap(finished);
+                }
+                for (const auto& conn : ready) {
+                    if (conn->fd >= 0) writeClient(conn);
+                }
+                continue;
+            }
+            auto it = connections.find(fd);
+            if (it == connections.end()) {
+                continue;
+            }
+            shared_ptr<Connection> conn = it->second;
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR | EPOLLRDHUP)) {
+                readClient(conn);
+            }
+            if (conn->fd >= 0 && (events[i].events & EPOLLOUT)) {
+                writeClient(conn);
+            }
+        }
+    }
+    return true;
+}
+
+void RequestServer::acceptClients() {
+    while (true) {
+        int fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return; // EAGAIN: no more pending clients (or a transient error)
+        }
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            close(fd);
+            continue;
+        }
+        connections[fd] = make_shared<Connection>(fd);
+    }
+}
+
+void RequestServer::readClient(const shared_ptr<Connection>& conn) {
+    char buffer[16384];
+    while (true) {
+        ssize_t received = recv(conn->fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            conn->input.append(buffer, static_cast<size_t>(received));
+            continue;
+        }
+        if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            conn->peer_closed = true;
+        }
+        if (received < 0 && errno == EINTR) continue;
+        break;
+    }
+
+    // Hand every complete line to the connection's queue
+    size_t start = 0, newline;
+    bool queued = false;
+    {
+        lock_guard<mutex> guard(conn->lock);
+        while ((newline = conn->input.find('\n', start)) != string::npos) {
+            conn->pending.emplace_back(conn->input, start, newline - start);
+            start = newline + 1;
+            queued = true;
+        }
+    }
+    conn->input.erase(0, start);
+    if (conn->input.size() > MAX_REQUEST_LINE) {
+        conn->peer_closed = true;
+    }
+    if (queued) {
+        schedule(conn);
+    }
+    if (conn->peer_closed) {
+        // Stop reading; close once queued requests are answered
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, conn->fd, nullptr);
+        conn->want_write = false;
+        writeClient(conn);
+    }
+}
+
+void RequestServer::schedule(const shared_ptr<Connection>& conn) {
+    {
+        lock_guard<mutex> guard(conn->lock);
+        if (conn->busy || conn->pending.empty()) {
+            return;
+        }
+        conn->busy = true;
+    }
+    workers->submit([this, conn]() { work(conn); });
+}
+
+void RequestServer::work(const shared_ptr<Connection>& conn) {
+    deque<string> lines;
+    {
+        lock_guard<mutex> guard(conn->lock);
+        lines.swap(conn->pending);
+    }
+
+    string results;
+    for (const string& text : lines) {
+        string_view line(text);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (line.find_first_not_of(" \t") == string_view::npos) continue;
+
+        BatchRequest request;
+        request.line = ++conn->line;
+        request.valid = request.fields.parse(line);
+        if (request.valid && BatchProcessor::isReadOnly(request.fields.get("op"))) {
+            shared_lock<shared_mutex> guard(engine_lock);
+            processor.execute(request, results, conn->sessions);
+        } else {
+            unique_lock<shared_mutex> guard(engine_lock);
+            processor.execute(request, results, conn->sessions);
+        }
+    }
+
+    // Lines that arrived meanwhile go to the back of the pool's queue rather than being run
+    // here, so a fast client cannot keep a worker to itself while other connections wait
+    bool more;
+    {
+        lock_guard<mutex> guard(conn->lock);
+        conn->output += results;
+        more = !conn->pending.empty();
+        conn->busy = more;
+    }
+    if (more) {
+        workers->submit([this, conn]() { work(conn); });
+    }
+    // Also lets the loop close a client that hung up, once its connection is idle
+    notify(conn);
+}
+
+void RequestServer::notify(const shared_ptr<Connection>& conn) {
+    {
+        lock_guard<mutex> guard(finished_lock);
+        finished.push_back(conn);
+    }
+    uint64_t one = 1;
+    if (write(wake_fd, &one, sizeof(one)) < 0) {
+        // Counter saturated: the loop is awake anyway
+    }
+}
+
+void RequestServer::writeClient(const shared_ptr<Connection>& conn) {
+    string output;
+    bool busy;
+    {
+        lock_guard<mutex> guard(conn->lock);
+        output.swap(conn->output);
+        busy = conn->busy;
+    }
+    size_t sent = 0;
+    while (sent < output.size()) {
+        ssize_t n = send(conn->fd, output.data() + sent, output.size() - sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += static_cast<size_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && !conn->peer_closed) {
+            break;
+        } else {
+            // Client gone, or it stopped sending and is not draining results: drop the rest
+            sent = output.size();
+            conn->peer_closed = true;
+        }
+    }
+    bool left_over = sent < output.size();
+    if (left_over) {
+        lock_guard<mutex> guard(conn->lock);
+        conn->output.insert(0, output, sent, string::npos);
+    }
+    if (conn->peer_closed) {
+        if (!busy && !left_over) closeClient(conn);
+        return;
+    }
+    setWriteInterest(conn, left_over);
+}
+
+void RequestServer::setWriteInterest(const shared_ptr<Connection>& conn, bool want) {
+    if (conn->want_write == want) {
+        return;
+    }
+    conn->want_write = want;
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLRDHUP | (want ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+    event.data.fd = conn->fd;
+    epoll_ctl(epoll_fd, EPOLL_CTL_MOD, conn->fd, &event);
+}
+
+void RequestServer::closeClient(const shared_ptr<Connection>& conn) {
+    if (conn->fd < 0) {
+        return;
+    }
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, conn->fd, nullptr);
+    connections.erase(conn->fd);
+    close(conn->fd);
+    conn->fd = -1;
+}
+
+#endif // __linux__
+
+#endif // SERVER_H
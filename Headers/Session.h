@@ -0,0 +1,690 @@
+#ifndef SESSION_H
+#define SESSION_H
+
+// Dialogue sessions are C++20 coroutines resumed by epoll loops: Linux and C++20 builds only
+#if defined(__linux__) && __cplusplus >= 202002L
+
+#include <coroutine>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <queue>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <utility>
+#include <cerrno>
+#include <cstring>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Hashtable.h"
+#include "Engine.h"
+#include "Lab.h"
+#include "Bus.h"
+#include "Parser.h"
+
+using namespace std;
+
+// Bytes currently held by session coroutine frames, over all sessions
+atomic<size_t> session_frame_bytes{0};
+
+// A client sending a line longer than this is disconnected
+const size_t MAX_DIALOGUE_LINE = 4096;
+
+template <class T = void>
+class Task;
+
+/**
+ * @brief Promise state shared by every Task: the coroutine to resume when this one finishes,
+ * and an exception to hand to it. Frames are allocated through here so they can be counted.
+ */
+struct TaskPromiseBase {
+    coroutine_handle<> continuation;
+    exception_ptr error;
+
+    static void* operator new(size_t size);
+    static void operator delete(void* frame, size_t size);
+
+    // Tasks are lazy: nothing runs until the task is awaited or started
+    suspend_always initial_suspend() noexcept { return {}; }
+
+    // On completion, jump straight back into the awaiting coroutine (no stack growth)
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+        template <class Promise>
+        coroutine_handle<> await_suspend(coroutine_handle<Promise> finished) noexcept {
+            coroutine_handle<> next = finished.promise().continuation;
+            return next ? next : noop_coroutine();
+        }
+        void await_resume() noexcept {}
+    };
+    FinalAwaiter final_suspend() noexcept { return {}; }
+
+    void unhandled_exception() { error = current_exception(); }
+};
+
+// Out of line: inlined into a coroutine, GCC 12 pairs these wrongly (-Wmismatched-new-delete)
+[[gnu::noinline]] void* TaskPromiseBase::operator new(size_t size) {
+    session_frame_bytes += size;
+    return ::operator new(size);
+}
+
+[[gnu::noinline]] void TaskPromiseBase::operator delete(void* frame, size_t size) {
+    session_frame_bytes -= size;
+    ::operator delete(frame);
+}
+
+template <class T>
+struct TaskPromise : TaskPromiseBase {
+    optional<T> value;
+    Task<T> get_return_object();
+    void return_value(T result) { value = move(result); }
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object();
+    void return_void() {}
+};
+
+/**
+ * @brief A coroutine returning T to whoever co_awaits it. The Task owns the coroutine frame;
+ * destroying a suspended task destroys its frame and, through its locals, the tasks it awaits.
+ */
+template <class T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = TaskPromise<T>;
+
+    Task() = default;
+    explicit Task(coroutine_handle<promise_type> handle) : handle(handle) {}
+    Task(Task&& other) noexcept : handle(exchange(other.handle, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = exchange(other.handle, {});
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() {
+        if (handle) handle.destroy();
+    }
+
+    // Runs a top-level task (one nobody awaits) until its first suspension
+    void start() { handle.resume(); }
+    bool done() const { return !handle || handle.done(); }
+
+    bool await_ready() const noexcept { return false; }
+    coroutine_handle<> await_suspend(coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+    T await_resume() {
+        if (handle.promise().error) {
+            rethrow_exception(handle.promise().error);
+        }
+        if constexpr (!is_void_v<T>) {
+            return move(*handle.promise().value);
+        }
+    }
+
+private:
+    coroutine_handle<promise_type> handle;
+};
+
+template <class T>
+Task<T> TaskPromise<T>::get_return_object() {
+    return Task<T>(coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+Task<void> TaskPromise<void>::get_return_object() {
+    return Task<void>(coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+/**
+ * @brief One client's side of a dialogue. The session coroutine co_awaits readLine(), which
+ * suspends it until the event loop feeds in a complete line (or the client hangs up), and
+ * write()s its prompts, which the loop sends when the coroutine next suspends.
+ */
+class SessionChannel {
+private:
+    string input;               // received bytes not yet read as lines
+    string output;              // written text not yet sent
+    coroutine_handle<> reader;  // the coroutine waiting in readLine(), if any
+    bool hung_up = false;
+
+    bool takeLine(string& line) {
+        size_t newline = input.find('\n');
+        if (newline == string::npos) {
+            return false;
+        }
+        size_t length = newline > 0 && input[newline - 1] == '\r' ? newline - 1 : newline;
+        line.assign(input, 0, length);
+        input.erase(0, newline + 1);
+        if (input.empty() && input.capacity() > 64) {
+            string().swap(input); // idle sessions keep no buffer
+        }
+        return true;
+    }
+
+public:
+    struct LineAwaiter {
+        SessionChannel& channel;
+        optional<string> line;
+
+        bool await_ready() {
+            string text;
+            if (channel.takeLine(text)) {
+                line = move(text);
+                return true;
+            }
+            return channel.hung_up;
+        }
+        void await_suspend(coroutine_handle<> waiting) { channel.reader = waiting; }
+        optional<string> await_resume() {
+            string text;
+            if (!line && channel.takeLine(text)) {
+                line = move(text);
+            }
+            return move(line);
+        }
+    };
+
+    // co_await readLine(): the next line without its newline, or nullopt once the client is gone
+    LineAwaiter readLine() { return {*this, nullopt}; }
+    void write(string_view text) { output += text; }
+    bool hungUp() const { return hung_up; }
+
+    // Event loop side: adds received bytes, resuming the reader once a line is complete
+    void feed(const char* bytes, size_t count) {
+        input.append(bytes, count);
+        if (reader && input.find('\n') != string::npos) {
+            exchange(reader, {}).resume();
+        }
+    }
+    // Event loop side: the client closed its end; a waiting reader gets nullopt
+    void hangUp() {
+        hung_up = true;
+        if (reader) {
+            exchange(reader, {}).resume();
+        }
+    }
+    string& pendingOutput() { return output; }
+    size_t bufferedInput() const { return input.size(); }
+};
+
+/**
+ * @brief Serves the interactive menu (login, browse, book, cancel, waitlist) as a text dialogue
+ * over a Unix-domain socket, e.g. with `nc -U`.
+ *
+ * Each client's conversation is a coroutine that suspends whenever it waits for the client's
+ * next line, so a session costs a small coroutine frame and a socket rather than a thread.
+ * A few event-loop threads share the clients. A coroutine only runs between two reads and
+ * never blocks, so the loops take turns on the engine under one lock.
+ */
+class SessionServer {
+private:
+    struct Client {
+        int fd;
+        bool want_write = false;
+        SessionChannel channel;
+        Task<> dialogue; // destroyed before the channel it reads from
+
+        explicit Client(int fd) : fd(fd) {}
+    };
+
+    struct Loop {
+        int epoll_fd = -1;
+        unordered_map<int, unique_ptr<Client>> clients;
+    };
+
+    HashTable& user_db;
+    map<int, Resource*>& resources;
+    mutex engine_lock;
+
+    int listen_fd = -1;
+    int wake_fd = -1; // eventfd left readable by stop(), waking every loop
+    string socket_path;
+    atomic<bool> stopping{false};
+    atomic<size_t> session_count{0};
+    vector<unique_ptr<Loop>> loops;
+
+    // The dialogue: the same steps as the menu's login and options 6 and 7
+    Task<> converse(SessionChannel& io);
+    Task<User*> login(SessionChannel& io);
+    Task<> bookFlow(SessionChannel& io, User* user);
+    Task<> cancelFlow(SessionChannel& io, User* user);
+    void listResources(SessionChannel& io);
+    void listBookings(SessionChannel& io, User* user);
+
+    void runLoop(Loop& loop);
+    void acceptClients(Loop& loop);
+    void serviceClient(Loop& loop, Client& client, uint32_t events);
+    bool flush(Loop& loop, Client& client); // false if the client is gone
+    void closeClient(Loop& loop, int fd);
+
+public:
+    // 0 loops means "one per hardware thread"
+    SessionServer(HashTable& user_db, map<int, Resource*>& resources, size_t loop_count = 1);
+    ~SessionServer();
+
+    SessionServer(const SessionServer&) = delete;
+    SessionServer& operator=(const SessionServer&) = delete;
+
+    // Binds and listens on a Unix-domain socket (an old socket file is replaced)
+    bool listen(const string& path);
+
+    // Runs the loops (one on the calling thread) until stop() is called
+    bool run();
+
+    // Asks run() to return; safe to call from any thread or a signal handler
+    void stop();
+
+    size_t sessionCount() const { return session_count; }
+    size_t loopCount() const { return loops.size(); }
+};
+
+SessionServer::SessionServer(HashTable& user_db, map<int, Resource*>& resources, size_t loop_count)
+    : user_db(user_db), resources(resources) {
+    if (loop_count == 0) {
+        loop_count = max(1u, thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < loop_count; ++i) {
+        loops.push_back(make_unique<Loop>());
+    }
+}
+
+SessionServer::~SessionServer() {
+    for (auto& loop : loops) {
+        for (auto& entry : loop->clients) {
+            close(entry.first);
+        }
+        loop->clients.clear();
+        if (loop->epoll_fd >= 0) close(loop->epoll_fd);
+    }
+    if (listen_fd >= 0) {
+        close(listen_fd);
+        unlink(socket_path.c_str());
+    }
+    if (wake_fd >= 0) close(wake_fd);
+}
+
+bool SessionServer::listen(const string& path) {
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    unlink(path.c_str());
+
+    listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0 || bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(listen_fd, SOMAXCONN) != 0) {
+        return false;
+    }
+    socket_path = path;
+
+    wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd < 0) {
+        return false;
+    }
+    for (auto& loop : loops) {
+        loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (loop->epoll_fd < 0) {
+            return false;
+        }
+        // Each new client wakes only one loop, which then owns it
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLEXCLUSIVE;
+        event.data.fd = listen_fd;
+        epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, listen_fd, &event);
+        event.events = EPOLLIN;
+        event.data.fd = wake_fd;
+        epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, wake_fd, &event);
+    }
+    return true;
+}
+
+void SessionServer::stop() {
+    stopping = true;
+    uint64_t one = 1;
+    if (wake_fd >= 0 && write(wake_fd, &one, sizeof(one)) < 0) {
+        // The loops are already being woken; nothing else to do
+    }
+}
+
+bool SessionServer::run() {
+    if (listen_fd < 0) {
+        return false;
+    }
+    vector<thread> threads;
+    for (size_t i = 1; i < loops.size(); ++i) {
+        threads.emplace_back(&SessionServer::runLoop, this, ref(*loops[i]));
+    }
+    runLoop(*loops[0]);
+    for (thread& t : threads) t.join();
+    return true;
+}
+
+void SessionServer::runLoop(Loop& loop) {
+    vector<epoll_event> events(256);
+    while (!stopping) {
+        int count = epoll_wait(loop.epoll_fd, events.data(), static_cast<int>(events.size()), -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == listen_fd) {
+                acceptClients(loop);
+                continue;
+            }
+            if (fd == wake_fd) {
+                continue; // stop(): the while condition ends the loop
+            }
+            auto it = loop.clients.find(fd);
+            if (it != loop.clients.end()) {
+                serviceClient(loop, *it->second, events[i].events);
+            }
+        }
+    }
+}
+
+void SessionServer::acceptClients(Loop& loop) {
+    while (true) {
+        int fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return; // EAGAIN: no more pending clients (or another loop took them)
+        }
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+        if (epoll_ctl(loop.epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            close(fd);
+            continue;
+        }
+        Client& client = *(loop.clients[fd] = make_unique<Client>(fd));
+        session_count++;
+        client.dialogue = converse(client.channel);
+        {
+            lock_guard<mutex> guard(engine_lock);
+            client.dialogue.start(); // greets and suspends at the first prompt
+        }
+        flush(loop, client);
+    }
+}
+
+void SessionServer::serviceClient(Loop& loop, Client& client, uint32_t events) {
+    int fd = client.fd;
+    if (events & (EPOLLIN | EPOLLHUP | EPOLLERR | EPOLLRDHUP)) {
+        char buffer[4096];
+        bool gone = false;
+        while (true) {
+            ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+            if (received > 0) {
+                lock_guard<mutex> guard(engine_lock);
+                client.channel.feed(buffer, static_cast<size_t>(received));
+                continue;
+            }
+            if (received < 0 && errno == EINTR) continue;
+            gone = received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+            break;
+        }
+        if (gone || client.channel.bufferedInput() > MAX_DIALOGUE_LINE) {
+            {
+                lock_guard<mutex> guard(engine_lock);
+                client.channel.hangUp(); // lets the dialogue finish; nobody is left to answer
+            }
+            closeClient(loop, fd);
+            return;
+        }
+    }
+    flush(loop, client); // also closes the client once it has chosen Quit and heard goodbye
+}
+
+bool SessionServer::flush(Loop& loop, Client& client) {
+    string& output = client.channel.pendingOutput();
+    size_t sent = 0;
+    while (sent < output.size()) {
+        ssize_t n = send(client.fd, output.data() + sent, output.size() - sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += static_cast<size_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            closeClient(loop, client.fd);
+            return false;
+        }
+    }
+    output.erase(0, sent);
+    if (output.empty() && output.capacity() > 1024) {
+        string().swap(output);
+    }
+
+    bool want_write = !output.empty();
+    if (want_write != client.want_write) {
+        client.want_write = want_write;
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP | (want_write ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+        event.data.fd = client.fd;
+        epoll_ctl(loop.epoll_fd, EPOLL_CTL_MOD, client.fd, &event);
+    }
+    if (client.dialogue.done() && output.empty()) {
+        closeClient(loop, client.fd);
+        return false;
+    }
+    return true;
+}
+
+void SessionServer::closeClient(Loop& loop, int fd) {
+    auto it = loop.clients.find(fd);
+    if (it == loop.clients.end()) {
+        return;
+    }
+    epoll_ctl(loop.epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    loop.clients.erase(it); // destroys a suspended dialogue's frames
+    session_count--;
+}
+
+Task<> SessionServer::converse(SessionChannel& io) {
+    io.write("Welcome to NUL Management.\n");
+    User* user = co_await login(io);
+    if (!user) {
+        co_return;
+    }
+    io.write("\nLogin successful! Welcome, " + string(user->getName()) + " (" + user->getType() + ").\n");
+
+    while (true) {
+        io.write("\n1. View Resources\n2. Add Booking\n3. Remove Booking\n4. View My Bookings\n5. Quit\nEnter your choice: ");
+        optional<string> choice = co_await io.readLine();
+        if (!choice) {
+            co_return;
+        }
+        if (*choice == "1") {
+            listResources(io);
+        } else if (*choice == "2") {
+            co_await bookFlow(io, user);
+        } else if (*choice == "3") {
+            co_await cancelFlow(io, user);
+        } else if (*choice == "4") {
+            listBookings(io, user);
+        } else if (*choice == "5") {
+            io.write("\nGoodbye!\n");
+            co_return;
+        } else {
+            io.write("Invalid choice. Please try again.\n");
+        }
+        if (io.hungUp()) {
+            co_return;
+        }
+    }
+}
+
+Task<User*> SessionServer::login(SessionChannel& io) {
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        io.write("\nEnter username: ");
+        optional<string> name = co_await io.readLine();
+        if (!name) {
+            co_return nullptr;
+        }
+        io.write("Enter password: ");
+        optional<string> password = co_await io.readLine();
+        if (!password) {
+            co_return nullptr;
+        }
+        if (User* user = user_db.login(*name, *password)) {
+            co_return user;
+        }
+        io.write("\nLogin failed. Invalid username or password.\n");
+    }
+    io.write("Too many failed attempts. Goodbye.\n");
+    co_return nullptr;
+}
+
+Task<> SessionServer::bookFlow(SessionChannel& io, User* user) {
+    listResources(io);
+    io.write("\nEnter Resource ID to book: ");
+    optional<string> answer = co_await io.readLine();
+    int rid;
+    if (!answer || !parse_int(*answer, rid)) {
+        io.write("\nInvalid input.\n");
+        co_return;
+    }
+    auto it = resources.find(rid);
+    if (it == resources.end()) {
+        io.write("\nResource ID not found.\n");
+        co_return;
+    }
+
+    if (is_slotted(it->second)) {
+        io.write("\nChoose from the available slots:\n");
+        for (const Slot& slot : dynamic_cast<Lab*>(it->second)->getSlots()) {
+            if (!slot.isBooked) {
+                io.write("  Slot " + to_string(slot.id) + ": " + slot.day + " " + slot.startTime + "-" + slot.endTime + "\n");
+            }
+        }
+        io.write("\nEnter slot ID to book: ");
+        answer = co_await io.readLine();
+        int sid;
+        if (!answer || !parse_int(*answer, sid)) {
+            io.write("\nInvalid input.\n");
+            co_return;
+        }
+        if (book_resource(resources, user, rid, sid) == EngineStatus::Ok) {
+            io.write("\nSuccessfully booked slot " + to_string(sid) + " for resource ID " + to_string(rid) + ".\n");
+            co_return;
+        }
+        io.write("\nSlot is either already booked or ID is invalid.\n");
+        io.write("\nWould you like to join the waitlist for this resource (ID " + to_string(rid) + ")? (y/n): ");
+        answer = co_await io.readLine();
+        if (answer && !answer->empty() && tolower((*answer)[0]) == 'y') {
+            EngineStatus status = join_waitlist(resources, user, rid);
+            io.write(status == EngineStatus::Ok ? "\nAdded to the waitlist.\n" : "\nCould not join the waitlist.\n");
+        }
+    } else if (Bus* bus = dynamic_cast<Bus*>(it->second)) {
+        io.write("\nEnter travel date (DD-MM-YYYY): ");
+        answer = co_await io.readLine();
+        int day;
+        if (!answer || !parse_date(*answer, day)) {
+            io.write("\nInvalid date.\n");
+            co_return;
+        }
+        EngineStatus status = book_resource(resources, user, rid, day);
+        if (status == EngineStatus::Ok) {
+            io.write("\nSuccessfully booked a seat on Bus ID " + to_string(rid) + " for " + *answer + " ("
+                     + to_string(bus->seatsLeft(day)) + " seats left).\n");
+        } else if (status == EngineStatus::InvalidDate) {
+            io.write("\nThe bus only runs from " + bus->getFromDate() + " to " + bus->getToDate() + ".\n");
+        } else {
+            vector<int> free_days = bus->daysWithSeats(day + 1, day + 14);
+            io.write("\nBus ID " + to_string(rid) + " is fully booked on " + *answer + ".");
+            if (!free_days.empty()) io.write(" Next date with seats: " + format_date(free_days.front()) + ".");
+            io.write("\n");
+        }
+    } else {
+        io.write("\nBooking not supported for this resource type.\n");
+    }
+}
+
+Task<> SessionServer::cancelFlow(SessionChannel& io, User* user) {
+    listBookings(io, user);
+    io.write("\nEnter Resource ID to cancel: ");
+    optional<string> answer = co_await io.readLine();
+    int rid;
+    if (!answer || !parse_int(*answer, rid)) {
+        io.write("\nInvalid input.\n");
+        co_return;
+    }
+    auto it = resources.find(rid);
+    if (it == resources.end()) {
+        io.write("\nResource ID not found.\n");
+        co_return;
+    }
+
+    int sid = -1;
+    if (is_slotted(it->second)) {
+        io.write("\nResource is slotted. Enter Slot ID to cancel: ");
+        answer = co_await io.readLine();
+        if (!answer || !parse_int(*answer, sid)) {
+            io.write("\nInvalid input.\n");
+            co_return;
+        }
+    } else if (dynamic_cast<Bus*>(it->second)) {
+        io.write("\nTravel date to cancel (DD-MM-YYYY, blank for all): ");
+        answer = co_await io.readLine();
+        if (!answer || (!answer->empty() && !parse_date(*answer, sid))) {
+            io.write("\nInvalid date.\n");
+            co_return;
+        }
+    }
+    EngineStatus status = cancel_booking(resources, user, rid, sid);
+    io.write(status == EngineStatus::Ok ? "\nBooking cancelled.\n" : "\nSlot not found or was not booked.\n");
+}
+
+void SessionServer::listResources(SessionChannel& io) {
+    io.write("\n--- Resources ---\n");
+    for (const auto& entry : resources) {
+        const Resource* resource = entry.second;
+        io.write("ID " + to_string(resource->getId()) + ": " + resource->getName() + " (" + resource->getType()
+                 + ") at " + resource->getLocation().getName() + "\n");
+    }
+}
+
+void SessionServer::listBookings(SessionChannel& io, User* user) {
+    const BookingList& bookings = user->getBookings();
+    io.write("\n--- My Bookings ---\n");
+    if (bookings.empty()) {
+        io.write("No bookings.\n");
+    }
+    for (const Booking& booking : bookings) {
+        const Resource* resource = booking.first;
+        int slot = booking.second;
+        io.write("ID " + to_string(resource->getId()) + ": " + resource->getName());
+        if (dynamic_cast<const Bus*>(resource) && slot >= 0) {
+            io.write(" on " + format_date(slot));
+        } else if (slot >= 0) {
+            io.write(", slot " + to_string(slot));
+        }
+        io.write("\n");
+    }
+}
+
+#endif // __linux__ && C++20
+
+#endif // SESSION_H
@@ -0,0 +1,161 @@
+#ifndef SMALLVECTOR_H
+#define SMALLVECTOR_H
+
+#include <vector>
+#include <new>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * @brief A vector that keeps its first N elements inside the object and only allocates when
+ * it grows past them. Meant for small per-record lists (a user's bookings): most records never
+ * touch the heap. Order is kept; erase() shifts the later elements down.
+ */
+template <class T, size_t N>
+class SmallVector {
+private:
+    uint32_t count = 0;
+    uint32_t capacity = N;
+    union {
+        T* heap;
+        alignas(T) unsigned char local[N * sizeof(T)];
+    };
+
+    bool onHeap() const { return capacity > N; }
+    T* items() { return onHeap() ? heap : reinterpret_cast<T*>(local); }
+    const T* items() const { return onHeap() ? heap : reinterpret_cast<const T*>(local); }
+
+    void grow() {
+        uint32_t grown = capacity * 2;
+        T* moved = static_cast<T*>(::operator new(sizeof(T) * grown));
+        T* old = items();
+        for (uint32_t i = 0; i < count; ++i) {
+            new (&moved[i]) T(std::move(old[i]));
+            old[i].~T();
+        }
+        if (onHeap()) ::operator delete(heap);
+        heap = moved;
+        capacity = grown;
+    }
+
+    // Takes other's elements, leaving it empty; this must be empty and inline
+    void steal(SmallVector& other) {
+        if (other.onHeap()) {
+            heap = other.heap;
+            capacity = other.capacity;
+            count = other.count;
+            other.capacity = N;
+        } else {
+            for (uint32_t i = 0; i < other.count; ++i) {
+                new (&items()[i]) T(std::move(other.items()[i]));
+                other.items()[i].~T();
+            }
+            count = other.count;
+        }
+        other.count = 0;
+    }
+
+public:
+    SmallVector() {}
+    SmallVector(const SmallVector& other) {
+        for (const T& value : other) push_back(value);
+    }
+    SmallVector(SmallVector&& other) noexcept { steal(other); }
+    ~SmallVector() {
+        clear();
+        if (onHeap()) ::operator delete(heap);
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            SmallVector copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this != &other) {
+            clear();
+            if (onHeap()) ::operator delete(heap);
+            capacity = N;
+            steal(other);
+        }
+        return *this;
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    T* begin() { return items(); }
+    T* end() { return items() + count; }
+    const T* begin() const { return items(); }
+    const T* end() const { return items() + count; }
+    T& operator[](size_t i) { return items()[i]; }
+    const T& operator[](size_t i) const { return items()[i]; }
+
+    void push_back(const T& value) {
+        if (count == capacity) {
+            T copy(value); // value may live in this vector
+            grow();
+            new (&items()[count++]) T(std::move(copy));
+            return;
+        }
+        new (&items()[count++]) T(value);
+    }
+
+    // Removes the element at index, keeping the order of the rest
+    void erase(size_t index) {
+        T* values = items();
+        for (size_t i = index; i + 1 < count; ++i) {
+            values[i] = std::move(values[i + 1]);
+        }
+        values[--count].~T();
+    }
+
+    void clear() {
+        T* values = items();
+        for (uint32_t i = 0; i < count; ++i) values[i].~T();
+        count = 0;
+    }
+};
+
+/**
+ * @brief First-in, first-out queue over a single vector. Unlike std::queue (a deque, which
+ * allocates as soon as it is constructed) an empty queue owns no memory. Popped slots at the
+ * front are reclaimed once they make up half the vector.
+ */
+template <class T>
+class CompactQueue {
+private:
+    vector<T> items;
+    size_t head = 0;
+
+public:
+    bool empty() const { return head == items.size(); }
+    size_t size() const { return items.size() - head; }
+    const T& front() const { return items[head]; }
+
+    void push(const T& value) { items.push_back(value); }
+    void pop() {
+        if (++head == items.size()) {
+            items.clear();
+            head = 0;
+        } else if (head >= 16 && head * 2 >= items.size()) {
+            items.erase(items.begin(), items.begin() + static_cast<ptrdiff_t>(head));
+            head = 0;
+        }
+    }
+    // Empties the queue and releases its memory
+    void clear() {
+        vector<T>().swap(items);
+        head = 0;
+    }
+
+    // The waiting elements, front first
+    typename vector<T>::const_iterator begin() const { return items.begin() + static_cast<ptrdiff_t>(head); }
+    typename vector<T>::const_iterator end() const { return items.end(); }
+};
+
+#endif // SMALLVECTOR_H
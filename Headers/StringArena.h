@@ -0,0 +1,73 @@
+#ifndef STRINGARENA_H
+#define STRINGARENA_H
+
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+
+using namespace std;
+
+// Text is packed into blocks of this size; longer strings get a block of their own
+const size_t STRING_ARENA_BLOCK_BYTES = 64 * 1024;
+
+/**
+ * @brief Bump allocator for short strings that live as long as their owner, such as the user
+ * table's names and password hashes. Strings are copied back to back into large blocks, so each
+ * one costs just its characters: no heap block, malloc header or spare capacity of its own.
+ *
+ * Nothing is freed until the arena is destroyed; text replaced by a later store() (a new
+ * password) stays behind until then. Safe to use from several threads.
+ */
+class StringArena {
+private:
+    mutex lock;
+    vector<unique_ptr<char[]>> blocks;
+    char* cursor = nullptr;
+    size_t left = 0;
+    size_t used = 0;
+    size_t reserved = 0;
+
+    char* allocate(size_t length) {
+        if (length > left) {
+            size_t block_bytes = max(length, STRING_ARENA_BLOCK_BYTES);
+            blocks.push_back(make_unique<char[]>(block_bytes));
+            reserved += block_bytes;
+            if (block_bytes > STRING_ARENA_BLOCK_BYTES) {
+                used += length;
+                return blocks.back().get(); // the current block keeps its free space
+            }
+            cursor = blocks.back().get();
+            left = block_bytes;
+        }
+        char* text = cursor;
+        cursor += length;
+        left -= length;
+        used += length;
+        return text;
+    }
+
+public:
+    // Copies text into the arena and returns the copy, which is not null-terminated
+    const char* store(string_view text) {
+        lock_guard<mutex> guard(lock);
+        char* copy = allocate(text.size());
+        if (!text.empty()) memcpy(copy, text.data(), text.size());
+        return copy;
+    }
+
+    // Bytes of text stored, and bytes of blocks allocated for it
+    size_t bytesUsed() {
+        lock_guard<mutex> guard(lock);
+        return used;
+    }
+    size_t bytesReserved() {
+        lock_guard<mutex> guard(lock);
+        return reserved;
+    }
+};
+
+#endif // STRINGARENA_H
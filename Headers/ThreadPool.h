@@ -0,0 +1,124 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <algorithm>
+
+#include "Trace.h"
+
+using namespace std;
+
+/**
+ * @brief Fixed-size pool of worker threads fed from a single task queue.
+ * Tasks are submitted as callables and their results come back through std::future.
+ */
+class ThreadPool {
+private:
+    vector<thread> workers;
+    queue<function<void()>> tasks;
+    mutex queue_mutex;
+    condition_variable task_available;
+    bool stopping = false;
+
+    void workerLoop();
+
+public:
+    // 0 threads means "one per hardware thread"
+    explicit ThreadPool(size_t thread_count = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    // Queues a task and returns a future for its result
+    template <class F>
+    auto submit(F&& task) -> future<decltype(task())> {
+        using R = decltype(task());
+        auto packaged = make_shared<packaged_task<R()>>(forward<F>(task));
+        future<R> result = packaged->get_future();
+        {
+            lock_guard<mutex> lock(queue_mutex);
+            tasks.emplace([packaged]() { (*packaged)(); });
+        }
+        task_available.notify_one();
+        return result;
+    }
+};
+
+ThreadPool::ThreadPool(size_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = max(1u, thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < thread_count; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(queue_mutex);
+        stopping = true;
+    }
+    task_available.notify_all();
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::workerLoop() {
+    tracer.nameThread("pool worker");
+    while (true) {
+        function<void()> task;
+        {
+            unique_lock<mutex> lock(queue_mutex);
+            task_available.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty()) {
+                return;
+            }
+            task = move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+
+/**
+ * @brief Shared pool used by the loaders and other bulk operations.
+ */
+ThreadPool& shared_thread_pool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+/**
+ * @brief Splits [0, count) into one contiguous range per worker and runs body(begin, end) on each.
+ * Blocks until every range is done. Small inputs run inline on the calling thread.
+ */
+void parallel_for(ThreadPool& pool, size_t count, const function<void(size_t, size_t)>& body,
+                  size_t min_per_task = 1) {
+    size_t task_count = min(pool.size(), max<size_t>(1, count / max<size_t>(1, min_per_task)));
+    if (task_count <= 1) {
+        if (count > 0) body(0, count);
+        return;
+    }
+    vector<future<void>> pending;
+    size_t per_task = (count + task_count - 1) / task_count;
+    for (size_t begin = 0; begin < count; begin += per_task) {
+        size_t end = min(count, begin + per_task);
+        pending.push_back(pool.submit([&body, begin, end]() { body(begin, end); }));
+    }
+    for (auto& f : pending) {
+        f.get();
+    }
+}
+
+#endif // THREADPOOL_H
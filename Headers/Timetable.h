@@ -0,0 +1,430 @@
+#ifndef TIMETABLE_H
+#define TIMETABLE_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdio>
+#include <climits>
+#include <iostream>
+#include <iomanip>
+
+#include "Map.h"
+#include "Bus.h"
+#include "Parser.h"
+#include "Log.h"
+#include "Trace.h"
+
+using namespace std;
+
+// Stops further apart than this (walking minutes) are not offered as transfers
+const double MAX_TRANSFER_WALK = 10.0;
+
+/**
+ * @brief Parses "HH:MM" into minutes after midnight. Returns false on malformed input.
+ */
+bool parse_clock_time(string_view text, double& minutes) {
+    size_t colon = text.find(':');
+    int hours, mins;
+    if (colon == string_view::npos || !parse_int(text.substr(0, colon), hours) || !parse_int(text.substr(colon + 1), mins)
+        || hours < 0 || hours > 47 || mins < 0 || mins > 59) {
+        return false;
+    }
+    minutes = hours * 60.0 + mins;
+    return true;
+}
+
+string format_clock_time(double minutes) {
+    int total = static_cast<int>(minutes + 0.5);
+    char text[8];
+    snprintf(text, sizeof(text), "%02d:%02d", (total / 60) % 24, total % 60);
+    return text;
+}
+
+/**
+ * @brief One bus ride between two consecutive stops of a trip.
+ */
+struct Connection {
+    uint32_t from_stop;
+    uint32_t to_stop;
+    double departure; // minutes after midnight
+    double arrival;
+    uint32_t trip;
+};
+
+/**
+ * @brief One leg of a journey: a walk or a ride on one bus trip.
+ */
+struct JourneyLeg {
+    bool ride;
+    string from;
+    string to;
+    double departure;
+    double arrival;
+    int bus_id; // resource ID of the bus (rides only)
+};
+
+struct Journey {
+    double departure = 0.0;
+    double arrival = INF;
+    vector<JourneyLeg> legs;
+
+    bool found() const { return arrival != INF; }
+};
+
+/**
+ * @brief Bus timetables over campus map stops, with earliest-arrival journey planning.
+ *
+ * Trips are stored as elementary connections sorted by departure time. A query walks from the
+ * origin to every stop (one search on the campus map), scans the connections departing after
+ * the start time once in order (Connection Scan Algorithm), allows walking transfers between
+ * nearby stops, and finally compares walking the rest of the way from each stop with walking
+ * the whole way. A query costs one map search plus one pass over the day's remaining
+ * connections, so thousands of trips per day stay cheap.
+ */
+class BusTimetable {
+private:
+    vector<string> stop_names;
+    unordered_map<string, uint32_t> stop_ids;
+    vector<Connection> connections;  // sorted by departure after finalize()
+    vector<int> trip_bus;            // trip -> bus resource ID
+    map<int, pair<int, int>> bus_days; // bus resource ID -> first and last day it runs
+    vector<pair<int, int>> trip_days;  // trip -> its bus's days, filled by finalize()
+    vector<vector<pair<uint32_t, double>>> transfers; // stop -> (stop, walking minutes)
+    bool finalized = false;
+
+    uint32_t stopId(const string& name);
+
+    // Walking minutes from `from` to every stop and to `target` (INF if unreachable)
+    void walkingTimes(const NULMapGraph& campus_map, const string& from, const string& target,
+                      vector<double>& to_stops, double& to_target) const;
+
+public:
+    /**
+     * @brief Adds one trip of a bus: the stops in order with the departure time at each
+     * (the time at the last stop is the arrival). Returns the trip number.
+     */
+    uint32_t addTrip(int bus_id, const vector<pair<string, double>>& stop_times);
+
+    /**
+     * @brief Adds trips every `headway` minutes from first_departure up to last_departure.
+     * travel[i] is the riding time from stops[i] to stops[i + 1].
+     */
+    void addService(int bus_id, const vector<string>& stops, const vector<double>& travel,
+                    double first_departure, double last_departure, double headway);
+
+    /**
+     * @brief Limits a bus's trips to the day numbers first_day..last_day (see parse_date).
+     * Trips of a bus without a range run every day. Takes effect at the next finalize().
+     */
+    void setRunningDays(int bus_id, int first_day, int last_day);
+
+    /**
+     * @brief Sorts the connections and computes walking transfers between stops. Call after
+     * adding trips and whenever the campus map changed.
+     */
+    void finalize(const NULMapGraph& campus_map);
+
+    size_t stopCount() const { return stop_names.size(); }
+    size_t tripCount() const { return trip_bus.size(); }
+    size_t connectionCount() const { return connections.size(); }
+    bool isStop(const string& name) const { return stop_ids.count(name) > 0; }
+
+    /**
+     * @brief Earliest-arrival journey from one building to another leaving at `departure`
+     * (minutes after midnight) on day number `day`, walking and riding the buses that run that
+     * day. Falls back to walking only when no bus gets there sooner.
+     */
+    Journey plan(const NULMapGraph& campus_map, const string& from, const string& to, double departure, int day) const;
+};
+
+uint32_t BusTimetable::stopId(const string& name) {
+    auto it = stop_ids.find(name);
+    if (it != stop_ids.end()) {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(stop_names.size());
+    stop_names.push_back(name);
+    stop_ids.emplace(name, id);
+    return id;
+}
+
+uint32_t BusTimetable::addTrip(int bus_id, const vector<pair<string, double>>& stop_times) {
+    uint32_t trip = static_cast<uint32_t>(trip_bus.size());
+    trip_bus.push_back(bus_id);
+    for (size_t i = 0; i + 1 < stop_times.size(); ++i) {
+        connections.push_back({stopId(stop_times[i].first), stopId(stop_times[i + 1].first),
+                               stop_times[i].second, stop_times[i + 1].second, trip});
+    }
+    finalized = false;
+    return trip;
+}
+
+void BusTimetable::addService(int bus_id, const vector<string>& stops, const vector<double>& travel,
+                              double first_departure, double last_departure, double headway) {
+    for (double start = first_departure; start <= last_departure; start += headway) {
+        vector<pair<string, double>> stop_times;
+        double time = start;
+        for (size_t i = 0; i < stops.size(); ++i) {
+            stop_times.push_back({stops[i], time});
+            if (i < travel.size()) time += travel[i];
+        }
+        addTrip(bus_id, stop_times);
+    }
+}
+
+void BusTimetable::setRunningDays(int bus_id, int first_day, int last_day) {
+    bus_days[bus_id] = {first_day, last_day};
+    finalized = false;
+}
+
+void BusTimetable::finalize(const NULMapGraph& campus_map) {
+    // Ties keep trip order so a trip's connections stay in sequence
+    stable_sort(connections.begin(), connections.end(), [](const Connection& a, const Connection& b) {
+        return a.departure < b.departure;
+    });
+
+    trip_days.assign(trip_bus.size(), {INT_MIN, INT_MAX});
+    for (size_t trip = 0; trip < trip_bus.size(); ++trip) {
+        auto it = bus_days.find(trip_bus[trip]);
+        if (it != bus_days.end()) trip_days[trip] = it->second;
+    }
+
+    transfers.assign(stop_names.size(), {});
+    DistanceMatrix walks = campus_map.walking_times(stop_names, stop_names);
+    for (uint32_t a = 0; a < stop_names.size(); ++a) {
+        for (uint32_t b = 0; b < stop_names.size(); ++b) {
+            if (a != b && walks.at(a, b) <= MAX_TRANSFER_WALK) {
+                transfers[a].push_back({b, walks.at(a, b)});
+            }
+        }
+    }
+    finalized = true;
+}
+
+void BusTimetable::walkingTimes(const NULMapGraph& campus_map, const string& from, const string& target,
+                                vector<double>& to_stops, double& to_target) const {
+    to_stops.assign(stop_names.size(), INF);
+    to_target = INF;
+    size_t remaining = stop_names.size() + 1;
+    campus_map.visit_by_distance(from, [&](const string& name, double minutes) {
+        auto it = stop_ids.find(name);
+        if (it != stop_ids.end()) {
+            to_stops[it->second] = minutes;
+            remaining--;
+        }
+        if (name == target) {
+            to_target = minutes;
+            remaining--;
+        }
+        return remaining == 0;
+    });
+}
+
+Journey BusTimetable::plan(const NULMapGraph& campus_map, const string& from, const string& to, double departure, int day) const {
+    Journey journey;
+    journey.departure = departure;
+    if (!finalized || !campus_map.has_node(from) || !campus_map.has_node(to)) {
+        return journey;
+    }
+
+    // How each stop was reached: walking from the origin, a ride, or a transfer walk
+    enum class Via { Origin, Ride, Transfer };
+    struct Label {
+        double arrival = INF;
+        Via via = Via::Origin;
+        uint32_t board = 0;  // Ride: connection where the trip was boarded
+        uint32_t alight = 0; // Ride: connection arriving here; Transfer: previous stop
+    };
+
+    size_t stop_count = stop_names.size();
+    vector<double> walk_from_origin, walk_to_target(stop_count, INF);
+    double direct_walk, ignored;
+    walkingTimes(campus_map, from, to, walk_from_origin, direct_walk);
+    // The map is undirected, so walking to the target equals walking from it
+    walkingTimes(campus_map, to, from, walk_to_target, ignored);
+
+    vector<Label> labels(stop_count);
+    for (uint32_t s = 0; s < stop_count; ++s) {
+        labels[s].arrival = departure + walk_from_origin[s];
+    }
+    double best = departure + direct_walk;
+    uint32_t best_stop = NO_NODE;
+
+    // Connection scan: trip_board[t] is the connection where trip t can first be boarded
+    vector<uint32_t> trip_board(trip_bus.size(), NO_NODE);
+    auto first = lower_bound(connections.begin(), connections.end(), departure, [](const Connection& c, double t) {
+        return c.departure < t;
+    });
+    for (uint32_t i = static_cast<uint32_t>(first - connections.begin()); i < connections.size(); ++i) {
+        const Connection& c = connections[i];
+        if (c.departure >= best) {
+            break; // nothing departing now can arrive earlier
+        }
+        if (day < trip_days[c.trip].first || day > trip_days[c.trip].second) {
+            continue; // the bus does not run that day
+        }
+        if (trip_board[c.trip] == NO_NODE && labels[c.from_stop].arrival <= c.departure) {
+            trip_board[c.trip] = i;
+        }
+        if (trip_board[c.trip] == NO_NODE || c.arrival >= labels[c.to_stop].arrival) {
+            continue;
+        }
+        labels[c.to_stop] = {c.arrival, Via::Ride, trip_board[c.trip], i};
+        if (c.arrival + walk_to_target[c.to_stop] < best) {
+            best = c.arrival + walk_to_target[c.to_stop];
+            best_stop = c.to_stop;
+        }
+        for (const auto& transfer : transfers[c.to_stop]) {
+            double arrival = c.arrival + transfer.second;
+            if (arrival < labels[transfer.first].arrival) {
+                labels[transfer.first] = {arrival, Via::Transfer, 0, c.to_stop};
+                if (arrival + walk_to_target[transfer.first] < best) {
+                    best = arrival + walk_to_target[transfer.first];
+                    best_stop = transfer.first;
+                }
+            }
+        }
+    }
+
+    journey.arrival = best;
+    if (best == INF) {
+        return journey;
+    }
+    if (best_stop == NO_NODE) {
+        journey.legs.push_back({false, from, to, departure, best, -1});
+        return journey;
+    }
+
+    // Walk back through the labels, then reverse
+    vector<JourneyLeg> legs;
+    legs.push_back({false, stop_names[best_stop], to, labels[best_stop].arrival, best, -1});
+    for (uint32_t s = best_stop; ; ) {
+        const Label& label = labels[s];
+        if (label.via == Via::Origin) {
+            legs.push_back({false, from, stop_names[s], departure, label.arrival, -1});
+            break;
+        }
+        if (label.via == Via::Transfer) {
+            uint32_t previous = label.alight;
+            legs.push_back({false, stop_names[previous], stop_names[s], labels[previous].arrival, label.arrival, -1});
+            s = previous;
+            continue;
+        }
+        const Connection& board = connections[label.board];
+        const Connection& alight = connections[label.alight];
+        legs.push_back({true, stop_names[board.from_stop], stop_names[s], board.departure, alight.arrival, trip_bus[alight.trip]});
+        s = board.from_stop;
+    }
+    reverse(legs.begin(), legs.end());
+
+    // Zero-length walks (origin is a stop, or alighting at the destination) are dropped
+    for (const JourneyLeg& leg : legs) {
+        if (leg.ride || leg.from != leg.to) journey.legs.push_back(leg);
+    }
+    return journey;
+}
+
+/**
+ * @brief Reads bus services from a timetable file, one per line:
+ * "SERVICE|bus ID|stop;stop;...|riding minutes;...|first departure HH:MM|last departure HH:MM|headway minutes".
+ * Blank lines and lines starting with '#' are skipped. A service only runs if its bus is a
+ * loaded BUS resource, and only on the days from the bus's fromDate to its toDate; services of
+ * other buses, or with stops that are not on the map, are skipped. The timetable is finalized
+ * even when the file is missing, so journeys can still be planned on foot. Returns false if
+ * the file cannot be read.
+ */
+bool load_timetable(BusTimetable& timetable, const string& path, const map<int, Resource*>& resources,
+                    const NULMapGraph& campus_map) {
+    TraceSpan span("startup", "load_timetable", path);
+    string buffer;
+    if (!read_file_buffer(path, buffer)) {
+        timetable.finalize(campus_map);
+        return false;
+    }
+    LineReader lines(buffer);
+    string_view line;
+    string_view fields[7];
+    int services = 0;
+    while (lines.next(line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        int bus_id;
+        double first, last, headway;
+        if (split_fields(line, '|', fields, 7) != 7 || fields[0] != "SERVICE" || !parse_int(fields[1], bus_id)
+            || !parse_clock_time(fields[4], first) || !parse_clock_time(fields[5], last)
+            || !parse_double(fields[6], headway) || headway <= 0.0) {
+            engine_log.warn("timetable", path, " line ", lines.lineNumber(), ": malformed entry (line skipped).");
+            continue;
+        }
+        auto it = resources.find(bus_id);
+        Bus* bus = it == resources.end() ? nullptr : dynamic_cast<Bus*>(it->second);
+        int first_day, last_day;
+        if (!bus) {
+            engine_log.info("timetable", path, " line ", lines.lineNumber(), ": bus ", bus_id, " is not loaded (service skipped).");
+            continue;
+        }
+        if (!parse_date(bus->getFromDate(), first_day) || !parse_date(bus->getToDate(), last_day)) {
+            engine_log.warn("timetable", path, " line ", lines.lineNumber(), ": bus ", bus_id, " has no valid dates (service skipped).");
+            continue;
+        }
+
+        vector<string> stops;
+        vector<double> travel;
+        FieldSplitter stop_splitter(fields[2], ';');
+        string_view field;
+        bool valid = true;
+        while (stop_splitter.next(field)) {
+            stops.emplace_back(field);
+            valid = valid && campus_map.has_node(stops.back());
+        }
+        FieldSplitter travel_splitter(fields[3], ';');
+        double minutes = 0.0;
+        while (travel_splitter.next(field)) {
+            valid = valid && parse_double(field, minutes) && minutes >= 0.0;
+            travel.push_back(minutes);
+        }
+        if (!valid || stops.size() < 2 || travel.size() + 1 != stops.size()) {
+            engine_log.warn("timetable", path, " line ", lines.lineNumber(), ": unknown stop or bad riding times (service skipped).");
+            continue;
+        }
+        timetable.setRunningDays(bus_id, first_day, last_day);
+        timetable.addService(bus_id, stops, travel, first, last, headway);
+        services++;
+    }
+    timetable.finalize(campus_map);
+    engine_log.info("timetable", "Loaded ", services, " bus services from ", path, ".");
+    return true;
+}
+
+/**
+ * @brief Prints a journey leg by leg with clock times.
+ */
+void print_journey(const string& from, const string& to, const Journey& journey) {
+    if (!journey.found()) {
+        cout << "\n------------------------------------------------------------------\n";
+        cout << "No journey found between " << from << " and " << to << ".\n";
+        cout << "------------------------------------------------------------------\n";
+        return;
+    }
+    cout << "\n========================== JOURNEY PLAN ==========================\n";
+    cout << "Origin: " << from << " (leave " << format_clock_time(journey.departure) << ")\n";
+    cout << "Destination: " << to << " (arrive " << format_clock_time(journey.arrival) << ")\n";
+    cout << "Total Time: " << fixed << setprecision(1) << journey.arrival - journey.departure << " minutes\n";
+    cout << "==================================================================\n";
+    for (const JourneyLeg& leg : journey.legs) {
+        if (leg.ride) {
+            cout << "   " << format_clock_time(leg.departure) << " Bus ID " << leg.bus_id << " from " << leg.from
+                 << " to " << leg.to << ", arrive " << format_clock_time(leg.arrival) << "\n";
+        } else {
+            cout << "   " << format_clock_time(leg.departure) << " Walk from " << leg.from << " to " << leg.to
+                 << " (" << fixed << setprecision(1) << leg.arrival - leg.departure << " min)\n";
+        }
+    }
+    cout << "------------------------------------------------------------------\n";
+}
+
+#endif // TIMETABLE_H
@@ -0,0 +1,198 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <fstream>
+#include <cstdint>
+#include <cstdio>
+
+using namespace std;
+
+// Spans a thread keeps; later ones are counted as dropped so a long server run cannot exhaust memory
+const size_t TRACE_MAX_EVENTS_PER_THREAD = size_t(1) << 20;
+
+/**
+ * @brief Profiling spans in the Chrome trace event format, which chrome://tracing and
+ * ui.perfetto.dev open as a timeline per thread.
+ *
+ * Tracing is off unless enable() is called; a span then costs one relaxed load and no clock
+ * reads. When on, every thread appends its finished spans (category, name, start, duration) to
+ * its own buffer, registered once like the metric shards, so threads never wait on each other.
+ * There is one instance, tracer.
+ */
+class Tracer {
+private:
+    struct Event {
+        const char* category;
+        const char* name;
+        string detail; // shown as args.detail; usually empty
+        int64_t start_ns;
+        int64_t duration_ns;
+    };
+    struct Buffer {
+        uint32_t tid = 0;
+        string thread_name;
+        mutex lock; // the owner's appends against write(); never contended while tracing
+        vector<Event> events;
+        uint64_t dropped = 0;
+    };
+
+    atomic<bool> on{false};
+    chrono::steady_clock::time_point origin = chrono::steady_clock::now();
+    mutex buffers_lock;
+    vector<unique_ptr<Buffer>> buffers;
+
+    Buffer& localBuffer() {
+        thread_local Buffer* buffer = nullptr;
+        if (!buffer) {
+            lock_guard<mutex> guard(buffers_lock);
+            buffers.push_back(make_unique<Buffer>());
+            buffer = buffers.back().get();
+            buffer->tid = static_cast<uint32_t>(buffers.size());
+        }
+        return *buffer;
+    }
+
+    static void writeString(ostream& out, string_view text);
+
+public:
+    // Starts recording; spans opened before this are not recorded
+    void enable() {
+        origin = chrono::steady_clock::now();
+        on.store(true, memory_order_release);
+    }
+    bool enabled() const { return on.load(memory_order_relaxed); }
+
+    // Names the calling thread in the trace (threads are otherwise "thread <n>")
+    void nameThread(const string& name) {
+        if (!enabled()) return;
+        Buffer& buffer = localBuffer();
+        lock_guard<mutex> guard(buffer.lock);
+        buffer.thread_name = name;
+    }
+
+    void record(const char* category, const char* name, chrono::steady_clock::time_point start,
+                chrono::steady_clock::time_point end, string detail = string()) {
+        Buffer& buffer = localBuffer();
+        lock_guard<mutex> guard(buffer.lock);
+        if (buffer.events.size() >= TRACE_MAX_EVENTS_PER_THREAD) {
+            buffer.dropped++;
+            return;
+        }
+        buffer.events.push_back({category, name, move(detail),
+                                 chrono::duration_cast<chrono::nanoseconds>(start - origin).count(),
+                                 chrono::duration_cast<chrono::nanoseconds>(end - start).count()});
+    }
+
+    // {"traceEvents":[...]} with one complete ("X") event per span and the thread names
+    void writeJson(ostream& out);
+    // Writes the trace to path; false if it cannot be written
+    bool write(const string& path);
+};
+
+// The engine's trace
+Tracer tracer;
+
+/**
+ * @brief Records the time from construction to destruction (or end()) as a span on the current
+ * thread. Does nothing while tracing is off.
+ */
+class TraceSpan {
+private:
+    const char* category;
+    const char* name;
+    string detail;
+    chrono::steady_clock::time_point started;
+    bool active;
+
+public:
+    TraceSpan(const char* category, const char* name) : category(category), name(name), active(tracer.enabled()) {
+        if (active) started = chrono::steady_clock::now();
+    }
+    // detail is shown with the span, e.g. a file name or request op
+    TraceSpan(const char* category, const char* name, const string& detail)
+        : category(category), name(name), active(tracer.enabled()) {
+        if (active) {
+            this->detail = detail;
+            started = chrono::steady_clock::now();
+        }
+    }
+    ~TraceSpan() { end(); }
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    // Ends the span early
+    void end() {
+        if (!active) return;
+        active = false;
+        tracer.record(category, name, started, chrono::steady_clock::now(), move(detail));
+    }
+};
+
+void Tracer::writeString(ostream& out, string_view text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+            out << escaped;
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+void Tracer::writeJson(ostream& out) {
+    char micros[32];
+    auto time_of = [&micros](int64_t ns) {
+        snprintf(micros, sizeof(micros), "%.3f", static_cast<double>(ns) / 1000.0);
+        return micros;
+    };
+    uint64_t dropped = 0;
+    out << "{\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"NUL_Management\"}}";
+    lock_guard<mutex> guard(buffers_lock);
+    for (const auto& buffer : buffers) {
+        lock_guard<mutex> buffer_guard(buffer->lock);
+        string thread_name = buffer->thread_name.empty() ? "thread " + to_string(buffer->tid) : buffer->thread_name;
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid << ",\"args\":{\"name\":";
+        writeString(out, thread_name);
+        out << "}}";
+        for (const Event& event : buffer->events) {
+            out << ",\n{\"name\":";
+            writeString(out, event.name);
+            out << ",\"cat\":";
+            writeString(out, event.category);
+            out << ",\"ph\":\"X\",\"ts\":" << time_of(event.start_ns);
+            out << ",\"dur\":" << time_of(event.duration_ns) << ",\"pid\":1,\"tid\":" << buffer->tid;
+            if (!event.detail.empty()) {
+                out << ",\"args\":{\"detail\":";
+                writeString(out, event.detail);
+                out << "}";
+            }
+            out << "}";
+        }
+        dropped += buffer->dropped;
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_spans\":\"" << dropped << "\"}}\n";
+}
+
+bool Tracer::write(const string& path) {
+    ofstream out(path);
+    if (!out.is_open()) {
+        return false;
+    }
+    writeJson(out);
+    return static_cast<bool>(out);
+}
+
+#endif // TRACE_H
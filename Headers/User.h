@@ -3,70 +3,164 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <queue>
+#include <atomic>
+#include <mutex>
 #include <algorithm>
 #include <limits> 
+#include <cstdint>
 
 #include "Resource.h"
 #include "Lab.h" 
+#include "Bus.h"
+#include "ChangeTracker.h"
+#include "Log.h"
+#include "SmallVector.h"
+#include "StringArena.h"
 
 using namespace std;
 
+// User roles. The named ones are built in; any other type read from users.txt is given the next
+// free value by user_type_of, so every type string survives a save.
+enum class UserType : uint8_t { Regular, Student, Lecturer, Admin };
+
+const size_t MAX_USER_TYPES = 256;
+
+/**
+ * @brief The type names behind UserType values. Names are only ever appended, and a slot is
+ * written before the count that publishes it, so lookups need no lock.
+ */
+struct UserTypeNames {
+    string names[MAX_USER_TYPES];
+    atomic<size_t> count{0};
+    mutex append_lock;
+
+    UserTypeNames() {
+        for (const char* name : {"Regular", "Student", "Lecturer", "Admin"}) {
+            names[count.load(memory_order_relaxed)] = name;
+            count.store(count.load(memory_order_relaxed) + 1, memory_order_release);
+        }
+    }
+};
+
+UserTypeNames& user_type_names() {
+    static UserTypeNames table;
+    return table;
+}
+
+// The UserType for a type name, adding the name if it is new
+UserType user_type_of(string_view name) {
+    UserTypeNames& table = user_type_names();
+    size_t known = table.count.load(memory_order_acquire);
+    for (size_t i = 0; i < known; ++i) {
+        if (table.names[i] == name) return static_cast<UserType>(i);
+    }
+    lock_guard<mutex> guard(table.append_lock);
+    size_t count = table.count.load(memory_order_relaxed);
+    for (size_t i = known; i < count; ++i) {
+        if (table.names[i] == name) return static_cast<UserType>(i);
+    }
+    if (count == MAX_USER_TYPES) {
+        engine_log.warn("users", "too many user types; '", name, "' is stored as Regular.");
+        return UserType::Regular;
+    }
+    table.names[count] = string(name);
+    table.count.store(count + 1, memory_order_release);
+    return static_cast<UserType>(count);
+}
+
+const string& user_type_name(UserType type) {
+    return user_type_names().names[static_cast<size_t>(type)];
+}
+
+// A booked resource and its slot (for a bus, the travel day; -1 when there is none)
+using Booking = pair<const Resource*, int>;
+// Most users hold a handful of bookings; up to this many are kept inside the User itself
+const size_t INLINE_BOOKINGS = 4;
+using BookingList = SmallVector<Booking, INLINE_BOOKINGS>;
 
 class User {
     private:
+        // Name and password hash, each kept in the arena of the table that holds the user
+        const char* name_text = nullptr;
+        const char* hash_text = nullptr;
+        uint32_t name_length = 0;
+        uint32_t hash_length = 0;
         int id;
-        string name;
-        string passwordHash; 
-        string type;
-        queue<pair<const Resource*, int>> bookings;
+        UserType type = UserType::Regular;
+        bool dirty = false; // changed since the last save
+        BookingList bookings;
 
     public:
         // Constructors
         User();
-        User(int id, const string& name, const string& passwordHash, string);
+        // name and passwordHash are copied into arena, which must outlive the user
+        User(int id, const string& name, const string& passwordHash, const string& type, StringArena& arena);
 
         // Getters
         int getId() const;
-        string getName() const;
-        string getPasswordHash() const;
-        string getType() const;
+        string_view getName() const;
+        string_view getPasswordHash() const;
+        const string& getType() const;
+        UserType getUserType() const { return type; }
 
         // Setters
-        void setId(int id);
-        void setName(const string& name);
-        void setPasswordHash(const string& passwordHash);
+        void setName(const string& name, StringArena& arena);
+        void setPasswordHash(const string& passwordHash, StringArena& arena);
         void setType(const string& type);
 
         // Utility Functions
         void addBooking(const Resource* booking, int sid);
-        void removeBooking(int itemID);
+        bool removeBooking(int itemID, int slotId = -1);
         void viewMyBookings() const;
-        queue<pair<const Resource*, int>> getBookings() const;
-        void loadBooking(int resourceId, int slotId);
+        const BookingList& getBookings() const;
+        void loadBooking(const Resource* resource, int slotId);
 
         void addToResourceWaitlist(Resource* resource);
+
+        // Change tracking (see save_users)
+        void markDirty();
+        bool isDirty() const { return dirty; }
+        void clearDirty() { dirty = false; }
 };
 
 // Constructors
-User::User()
-    : id(0), name(""), passwordHash(""), type(""), bookings() {}
+User::User() : id(0) {}
 
-User::User(int id, const string& name, const string& passwordHash, string type)
-    : id(id), name(name), passwordHash(passwordHash), type(type), bookings() {}
+User::User(int id, const string& name, const string& passwordHash, const string& type, StringArena& arena)
+    : name_text(arena.store(name)), hash_text(arena.store(passwordHash)),
+      name_length(static_cast<uint32_t>(name.size())), hash_length(static_cast<uint32_t>(passwordHash.size())),
+      id(id), type(user_type_of(type)) {
+    markDirty();
+}
 
 // Getters
 int User::getId() const { return id; }
-string User::getName() const { return name; }
-string User::getPasswordHash() const { return passwordHash; }
-string User::getType() const { return type; }
+string_view User::getName() const { return string_view(name_text, name_length); }
+string_view User::getPasswordHash() const { return string_view(hash_text, hash_length); }
+const string& User::getType() const { return user_type_name(type); }
 
 // Setters
-void User::setId(int id) { this->id = id; }
-void User::setName(const string& name) { this->name = name; }
-void User::setPasswordHash(const string& passwordHash) { this->passwordHash = passwordHash; }
-void User::setType(const string& type) { this->type = type; }
+void User::setName(const string& name, StringArena& arena) {
+    name_text = arena.store(name);
+    name_length = static_cast<uint32_t>(name.size());
+    markDirty();
+}
+void User::setPasswordHash(const string& passwordHash, StringArena& arena) {
+    hash_text = arena.store(passwordHash);
+    hash_length = static_cast<uint32_t>(passwordHash.size());
+    markDirty();
+}
+void User::setType(const string& type) { this->type = user_type_of(type); markDirty(); }
+
+// Change tracking: report the id once per clean -> dirty transition
+void User::markDirty() {
+    if (!dirty) {
+        dirty = true;
+        user_changes().record(id);
+    }
+}
 
 // Utility Functions
 
@@ -75,56 +169,56 @@ void User::setType(const string& type) { this->type = type; }
  * @param booking A constant pointer to the booked Resource object.
  */
 void User::addBooking(const Resource* booking, int slotId = -1) {
-    bookings.push(make_pair(booking, slotId));
-    cout << "  Booking confirmed: Resource ID " << booking->getId() << " added to your list.\n";
+    bookings.push_back(make_pair(booking, slotId));
+    markDirty();
+    engine_log.info("booking", "Booking confirmed: Resource ID ", booking->getId(), " added to your list.");
 }
 
-queue<pair<const Resource*, int>> User::getBookings() const {
+const BookingList& User::getBookings() const {
     return bookings;
 }
 
 /**
  * @brief Removes a booking from the user's list based on the Resource ID.
  * @param itemID The ID of the resource to remove.
+ * @param slotId If not -1, only the booking of that slot (or bus travel day) is removed.
+ * @return true if a booking was removed.
  */
-void User::removeBooking(int itemID) {
-    queue<pair<const Resource*, int>> temp_queue;
+bool User::removeBooking(int itemID, int slotId) {
     bool found = false;
 
-    while (!bookings.empty()) {
-        const pair<const Resource*, int>& r = bookings.front();
-        bookings.pop();
+    for (size_t i = 0; i < bookings.size();) {
+        const Booking& r = bookings[i];
 
-        if (r.first->getId() == itemID) {
+        // With a slot given, only its first booking goes
+        if (r.first->getId() == itemID && (slotId == -1 || (r.second == slotId && !found))) {
             found = true;
-            cout << "  Booking for Resource ID " << itemID << " successfully removed.\n";
-            continue; // Skip adding this resource to the temp queue
+            engine_log.info("booking", "Booking for Resource ID ", itemID, " successfully removed.");
+            bookings.erase(i); // the rest keep their order
+            continue;
         }
-        temp_queue.push(r);
+        ++i;
     }
 
-    bookings = temp_queue; // Restore the bookings queue without the removed item
+    if (found) {
+        markDirty();
+    }
 
     if (!found) {
-        cout << "  Booking for Resource ID " << itemID << " not found in your list.\n";
+        engine_log.info("booking", "Booking for Resource ID ", itemID, " not found in your list.");
     }
+    return found;
 }
 
 void User::viewMyBookings() const {
-    std::cout << "\nBookings for user '" << name << "' (id=" << id << ")\n";
+    std::cout << "\nBookings for user '" << getName() << "' (id=" << id << ")\n";
     
-    // Check the size of the original queue
     if (bookings.empty()) { 
         std::cout << "  (no current bookings)\n";
     } else {
-        // 1. Create a temporary COPY of the bookings queue to iterate through.
-        queue<pair<const Resource*, int>> temp_bookings = bookings;
-
-        // 2. Iterate using a while loop until the temporary queue is empty.
-        while (!temp_bookings.empty()) {
-            
-            // Get the element at the front
-            const Resource* resource = temp_bookings.front().first; 
+        // Bookings are listed in the order they were made
+        for (const Booking& booking : bookings) {
+            const Resource* resource = booking.first; 
             
             // Print the booking details
             std::cout << "  - Resource ID: " << resource->getId()
@@ -136,9 +230,9 @@ void User::viewMyBookings() const {
             const Lab* lab_resource = dynamic_cast<const Lab*>(resource);
             if (lab_resource) {
                 std::cout << "    (Contains " << lab_resource->getSlots().size() << " time slots.)\n";
+            } else if (resource->getType() == "BUS" && booking.second >= 0) {
+                std::cout << "    (Travel date: " << format_date(booking.second) << ")\n";
             }
-
-            temp_bookings.pop(); 
         }
     }
     std::cout << "=======================================\n";
@@ -157,24 +251,18 @@ void User::addToResourceWaitlist(Resource* resource) {
         // Lab::addToWaitlist handles the actual queue push and confirmation message.
         lab_resource->addToWaitlist(this->id);
     } else {
-        cout << "? Error: Resource type '" << resource->getType() << "' does not support a waitlist.\n";
+        engine_log.warn("waitlist", "Resource type '", resource->getType(), "' does not support a waitlist.");
     }
 }
 
-void User::loadBooking(int resourceId, int slotId = -1) {
-    // Create a temporary Resource object with the given ID
-    pair<Resource*, int> booking = make_pair(new Resource(), -1);
-    booking.first->setId(resourceId);
-    if(slotId != -1) {
-        // If slotId is valid, we assume it's a Lab or LectureHall
-        Lab* lab_booking = new Lab();
-        lab_booking->setId(resourceId);
-        lab_booking->bookSlot(slotId);
-        // Here we could load the specific slot details if needed
-        booking.first = lab_booking;
-    }
-    // Add to bookings queue
-    bookings.push(booking);
+/**
+ * @brief Restores a saved booking, linking it to the already-loaded resource.
+ * @param resource The resource from the registry.
+ * @param slotId The booked slot (-1 for unslotted resources such as buses).
+ */
+void User::loadBooking(const Resource* resource, int slotId = -1) {
+    bookings.push_back(make_pair(resource, slotId));
+    markDirty();
 }
 
 
@@ -6,9 +6,13 @@
 #include <map>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <limits>
 #include <algorithm>
+#include <set>
+#include <iomanip>
+#include <filesystem>
 
 #include "Hashtable.h"
 #include "User.h"
@@ -17,12 +21,25 @@
 #include "Bus.h"
 #include "LectureHall.h"
 #include "Slot.h"
+#include "Parser.h"
+#include "ThreadPool.h"
+#include "ChangeTracker.h"
+#include "Log.h"
+#include "Metrics.h"
+#include "Trace.h"
 
 using namespace std;
 
 const string RESOURCE_FILE = "resources.txt";
 const string USER_FILE = "users.txt";
 
+// Segmented layout: one file per block of RECORDS_PER_SEGMENT consecutive IDs, so a save only
+// rewrites the blocks that contain changed records. The single-file layout above is still read
+// when no segment directory exists yet.
+const string RESOURCE_SEGMENT_DIR = "resources.d";
+const string USER_SEGMENT_DIR = "users.d";
+const int RECORDS_PER_SEGMENT = 256;
+
 extern int next_user_id;
 extern int next_resource_id;
 
@@ -31,124 +48,465 @@ extern map<int, Resource*> resources_table;
 // Function Prototypes
 void save_resources(const map<int, Resource*>& resources_map);
 void load_resources(map<int, Resource*>& resources_map);
-void save_users(const HashTable& user_table);
+void save_users(HashTable& user_table);
 void load_users(HashTable& user_table);
 
 /**
- * @brief Serializes all resources (Labs, Buses, LectureHalls) and their slot/waitlist data to a text file.
+ * @brief Writes one resource record (without the trailing newline).
  * Format (LAB/LECTUREHALL): ID|Type|Name|LocationName|Available|Slots:SId,Day,Start,End,Booked;...|Waitlist:UId,UId,...
- * Format (BUS): ID|BUS|Name|LocationName|Available|FromDate|ToDate
+ * Format (BUS): ID|BUS|Name|LocationName|Available|FromDate|ToDate|Capacity:Seats
  */
-void save_resources(const map<int, Resource*>& resources_map) {
-    ofstream outfile(RESOURCE_FILE);
+void write_resource_record(ostream& outfile, Resource* r) {
+    outfile << r->getId() << "|"
+            << r->getType() << "|"
+            << r->getName() << "|"
+            << r->getLocation().getName() << "|"
+            << r->getAvailability() << "|";
+
+    if (r->getType() == "BUS") {
+        Bus* bus_ptr = dynamic_cast<Bus*>(r);
+        outfile << bus_ptr->getFromDate() << "|" << bus_ptr->getToDate() << "|Capacity:" << bus_ptr->getCapacity();
+    } else if (r->getType() == "LAB" || r->getType() == "LECTUREHALL") {
+        Lab* lab_ptr = dynamic_cast<Lab*>(r);
+
+        // 1. Slots
+        outfile << "Slots:";
+        vector<Slot> slots = lab_ptr->getSlots();
+        for (const auto& s : slots) {
+            outfile << s.id << "," << s.day << "," << s.startTime << "," << s.endTime << "," << s.isBooked << ";";
+        }
+        outfile << "|";
+
+        // 2. Waitlist
+        outfile << "Waitlist:";
+        bool first = true;
+        for (int userId : lab_ptr->getWaitlist()) {
+            // Comma-separated, front of the queue first
+            if (!first) {
+                outfile << ",";
+            }
+            outfile << userId;
+            first = false;
+        }
+    }
+}
+
+/**
+ * @brief Writes one user record (without the trailing newline).
+ * Format: ID|Name|PasswordHash|Type|Bookings:RId,SId;RId,SId;...
+ * (for a bus booking SId is the travel day, see parse_date)
+ */
+void write_user_record(ostream& outfile, const User& user) {
+    outfile << user.getId() << "|" 
+            << user.getName() << "|" 
+            << user.getPasswordHash() << "|" 
+            << user.getType() << "|";
+
+    outfile << "Bookings:";
+
+    // Format: RId,SId;RId,SId;...
+    for (const Booking& booking_pair : user.getBookings()) {
+        // The pair contains {Resource Pointer, Slot ID}
+
+        // Write Resource ID (RId)
+        outfile << booking_pair.first->getId() << ",";
+
+        // Write Slot ID (SId) and the delimiter
+        outfile << booking_pair.second << ";";
+    }
+}
+
+int segment_of(int id) {
+    return id >= 0 ? id / RECORDS_PER_SEGMENT : (id - RECORDS_PER_SEGMENT + 1) / RECORDS_PER_SEGMENT;
+}
+
+string segment_path(const string& dir, int segment) {
+    ostringstream path;
+    path << dir << "/segment_" << setw(6) << setfill('0') << segment << ".txt";
+    return path.str();
+}
+
+/**
+ * @brief Segment files of a segmented layout, in segment order (empty if the directory does not exist).
+ */
+vector<string> list_segment_files(const string& dir) {
+    vector<string> paths;
+    error_code ec;
+    if (!filesystem::is_directory(dir, ec)) {
+        return paths;
+    }
+    for (const auto& entry : filesystem::directory_iterator(dir, ec)) {
+        string file_name = entry.path().filename().string();
+        if (entry.is_regular_file() && file_name.rfind("segment_", 0) == 0 && entry.path().extension() == ".txt") {
+            paths.push_back(entry.path().string());
+        }
+    }
+    sort(paths.begin(), paths.end());
+    return paths;
+}
+
+/**
+ * @brief Rewrites one segment file from the records whose IDs are given (an empty list removes it).
+ * The segment is written to a temporary file and renamed over the old one, so a failed save
+ * leaves the previous segment intact.
+ */
+template <class WriteRecord>
+bool write_segment(const string& dir, int segment, const vector<int>& ids, WriteRecord write_record) {
+    string final_path = segment_path(dir, segment);
+    error_code ec;
+    if (ids.empty()) {
+        filesystem::remove(final_path, ec);
+        return !ec;
+    }
+
+    string temp_path = final_path + ".tmp";
+    ofstream outfile(temp_path);
     if (!outfile.is_open()) {
-        cerr << "\nERROR: Could not open " << RESOURCE_FILE << " for writing.\n";
+        return false;
+    }
+    for (int id : ids) {
+        write_record(outfile, id);
+        outfile << "\n";
+    }
+    outfile.close();
+    if (!outfile) {
+        filesystem::remove(temp_path, ec);
+        return false;
+    }
+    filesystem::rename(temp_path, final_path, ec);
+    return !ec;
+}
+
+/**
+ * @brief Saves resources that changed since the last save.
+ * Only the segments holding changed (or removed) resources are rewritten, so the cost follows the
+ * number of changes rather than the number of resources.
+ */
+void save_resources(const map<int, Resource*>& resources_map) {
+    MetricTimer timer(Metric::SaveResources);
+    vector<int> changed = resource_changes().take();
+    if (changed.empty()) {
+        engine_log.info("storage", "No resource changes to save.");
         return;
     }
 
-    for (const auto& pair : resources_map) {
-        Resource* r = pair.second;
+    error_code ec;
+    filesystem::create_directories(RESOURCE_SEGMENT_DIR, ec);
+    if (ec) {
+        engine_log.error("storage", "Could not create ", RESOURCE_SEGMENT_DIR, " for writing.");
+        timer.fail();
+        for (int id : changed) resource_changes().record(id);
+        return;
+    }
 
-        outfile << r->getId() << "|"
-                << r->getType() << "|"
-                << r->getName() << "|"
-                << r->getLocation().getName() << "|"
-                << r->getAvailability() << "|";
+    set<int> segments;
+    for (int id : changed) {
+        segments.insert(segment_of(id));
+    }
 
-        if (r->getType() == "BUS") {
-            Bus* bus_ptr = dynamic_cast<Bus*>(r);
-            outfile << bus_ptr->getFromDate() << "|" << bus_ptr->getToDate();
-        } else if (r->getType() == "LAB" || r->getType() == "LECTUREHALL") {
-            Lab* lab_ptr = dynamic_cast<Lab*>(r);
+    int written = 0;
+    for (int segment : segments) {
+        int first_id = segment * RECORDS_PER_SEGMENT;
+        vector<int> ids;
+        for (auto it = resources_map.lower_bound(first_id);
+             it != resources_map.end() && it->first < first_id + RECORDS_PER_SEGMENT; ++it) {
+            ids.push_back(it->first);
+        }
 
-            // 1. Slots
-            outfile << "Slots:";
-            vector<Slot> slots = lab_ptr->getSlots();
-            for (const auto& s : slots) {
-                outfile << s.id << "," << s.day << "," << s.startTime << "," << s.endTime << "," << s.isBooked << ";";
+        // A lab whose slots could not be read would be written back empty; keep the segment as it is
+        bool readable = all_of(ids.begin(), ids.end(), [&resources_map](int id) {
+            Lab* lab = dynamic_cast<Lab*>(resources_map.at(id));
+            return !lab || lab->slotsAvailable();
+        });
+        if (!readable) {
+            engine_log.error("storage", "Kept ", segment_path(RESOURCE_SEGMENT_DIR, segment),
+                             ": it holds a lab whose slots could not be read.");
+            timer.fail();
+            for (int id : changed) {
+                if (segment_of(id) == segment) resource_changes().record(id);
             }
-            outfile << "|";
-
-            // 2. Waitlist
-            outfile << "Waitlist:";
-            queue<int> waitlist_users;
-            waitlist_users = lab_ptr->getWaitlist();
-            while (!waitlist_users.empty()) {
-                // Access the element at the front
-                int userId = waitlist_users.front(); 
-                
-                // Print the element
-                outfile << userId;
-
-                // Remove the element from the queue
-                waitlist_users.pop(); 
-
-                // Add a comma for separation, unless it's the last element
-                if (!waitlist_users.empty()) {
-                    outfile << ",";
-                }
+            continue;
+        }
+
+        bool ok = write_segment(RESOURCE_SEGMENT_DIR, segment, ids, [&resources_map](ostream& out, int id) {
+            write_resource_record(out, resources_map.at(id));
+        });
+        if (!ok) {
+            engine_log.error("storage", "Could not write ", segment_path(RESOURCE_SEGMENT_DIR, segment), ".");
+            timer.fail();
+            for (int id : changed) {
+                if (segment_of(id) == segment) resource_changes().record(id);
             }
+            continue;
         }
-        outfile << "\n";
+        for (int id : ids) {
+            resources_map.at(id)->clearDirty();
+        }
+        written++;
     }
 
-    outfile.close();
-    cout << "\nSaved all resources and their states to " << RESOURCE_FILE << ".\n";
+    engine_log.info("storage", "Saved ", written, " changed resource segment(s) to ", RESOURCE_SEGMENT_DIR, "/.");
 }
 
 /**
- * @brief Serializes all users and their booking/waitlist information to a text file.
- * Format: ID|Name|PasswordHash|Type|Bookings:RId,SId;RId,SId;...
+ * @brief Saves users that changed since the last save, rewriting only their segments.
  */
-void save_users(const HashTable& user_table) {
-    ofstream outfile(USER_FILE);
-    if (!outfile.is_open()) {
-        cerr << "\nERROR: Could not open " << USER_FILE << " for writing.\n";
+void save_users(HashTable& user_table) {
+    MetricTimer timer(Metric::SaveUsers);
+    vector<int> changed = user_changes().take();
+    if (changed.empty()) {
+        engine_log.info("storage", "No user changes to save.");
         return;
     }
 
-    for (const auto& bucket : user_table.getAllUsers()) {
-        for (const User& user : bucket) {
-             outfile << user.getId() << "|" 
-                     << user.getName() << "|" 
-                     << user.getPasswordHash() << "|" 
-                     << user.getType() << "|";
-            
-             // 1. Get a temporary COPY of the user's bookings queue.
-            queue<pair<const Resource*, int>> temp_bookings = user.getBookings(); 
-
-            outfile << "Bookings:";
-
-            // Format: RId,SId;RId,SId;...
-            while (!temp_bookings.empty()) {
-                
-                // Access the pair at the front
-                const auto& booking_pair = temp_bookings.front(); 
-                
-                // The pair contains {Resource Pointer, Slot ID}
-                
-                // Write Resource ID (RId)
-                outfile << booking_pair.first->getId() << ",";
-                
-                // Write Slot ID (SId) and the delimiter
-                outfile << booking_pair.second << ";";
-                
-                // Remove the element from the temporary queue
-                temp_bookings.pop(); 
+    error_code ec;
+    filesystem::create_directories(USER_SEGMENT_DIR, ec);
+    if (ec) {
+        engine_log.error("storage", "Could not create ", USER_SEGMENT_DIR, " for writing.");
+        timer.fail();
+        for (int id : changed) user_changes().record(id);
+        return;
+    }
+
+    set<int> segments;
+    for (int id : changed) {
+        segments.insert(segment_of(id));
+    }
+
+    int written = 0;
+    for (int segment : segments) {
+        int first_id = segment * RECORDS_PER_SEGMENT;
+        vector<int> ids = user_table.idsInRange(first_id, first_id + RECORDS_PER_SEGMENT);
+        ids.erase(remove_if(ids.begin(), ids.end(), [&user_table](int id) { return !user_table.getById(id); }), ids.end());
+
+        bool ok = write_segment(USER_SEGMENT_DIR, segment, ids, [&user_table](ostream& out, int id) {
+            write_user_record(out, *user_table.getById(id));
+        });
+        if (!ok) {
+            engine_log.error("storage", "Could not write ", segment_path(USER_SEGMENT_DIR, segment), ".");
+            timer.fail();
+            for (int id : changed) {
+                if (segment_of(id) == segment) user_changes().record(id);
             }
-            
-            outfile << "\n";
+            continue;
+        }
+        for (int id : ids) {
+            user_table.getById(id)->clearDirty();
         }
+        written++;
     }
-    
-    outfile.close();
-    cout << "\nSaved all users to " << USER_FILE << ".\n";
+
+    engine_log.info("storage", "Saved ", written, " changed user segment(s) to ", USER_SEGMENT_DIR, "/.");
 }
 
+// Files smaller than this are parsed on the calling thread; larger ones are split into chunks.
+const size_t PARALLEL_LOAD_THRESHOLD = 1 << 20;
+
+/**
+ * @brief A malformed line found while parsing. Line numbers are relative to the chunk being parsed
+ * until the chunks are merged.
+ */
+struct ParseIssue {
+    int line;
+    string reason;
+};
+
+/**
+ * @brief Reports malformed lines in a data file instead of aborting the load.
+ */
+void report_malformed(const string& file, const vector<ParseIssue>& issues, int line_offset = 0) {
+    for (const ParseIssue& issue : issues) {
+        engine_log.warn("storage", file, " line ", issue.line + line_offset, ": ", issue.reason, " (line skipped).");
+    }
+}
+
+/**
+ * @brief Splits a buffer into at most `max_chunks` pieces that each end on a newline boundary.
+ */
+vector<string_view> split_into_chunks(string_view buffer, size_t max_chunks) {
+    vector<string_view> chunks;
+    size_t target = buffer.size() / max<size_t>(1, max_chunks) + 1;
+    size_t begin = 0;
+    while (begin < buffer.size()) {
+        size_t end = min(buffer.size(), begin + target);
+        if (end < buffer.size()) {
+            size_t newline = buffer.find('\n', end);
+            end = (newline == string_view::npos) ? buffer.size() : newline + 1;
+        }
+        chunks.push_back(buffer.substr(begin, end - begin));
+        begin = end;
+    }
+    return chunks;
+}
+
+/**
+ * @brief Number of lines a chunk contributes to the file (used to turn chunk-relative line numbers into absolute ones).
+ */
+int count_lines(string_view chunk) {
+    int lines = static_cast<int>(count(chunk.begin(), chunk.end(), '\n'));
+    if (!chunk.empty() && chunk.back() != '\n') {
+        lines++;
+    }
+    return lines;
+}
+
+/**
+ * @brief The files a loader should read: the segment files when a segmented layout exists,
+ * otherwise the single-file layout (empty if neither exists).
+ */
+vector<string> data_files(const string& segment_dir, const string& single_file, bool& segmented) {
+    vector<string> paths = list_segment_files(segment_dir);
+    segmented = !paths.empty();
+    if (!segmented && filesystem::exists(single_file)) {
+        paths.push_back(single_file);
+    }
+    return paths;
+}
+
+/**
+ * @brief A data file being loaded: its path (shared with any lazily loaded records) and contents.
+ */
+struct DataFile {
+    shared_ptr<const string> path;
+    string contents;
+};
+
+/**
+ * @brief Reads the given files and parses them in newline-aligned chunks on the shared thread pool.
+ * Small inputs are parsed on the calling thread. Chunks come back in file order.
+ */
+template <class Chunk>
+vector<Chunk> parse_data_files(const vector<string>& paths, Chunk (*parse_chunk)(string_view, const DataFile&)) {
+    TraceSpan reading("storage", "read_files");
+    vector<DataFile> files(paths.size());
+    size_t total_size = 0;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        files[i].path = make_shared<const string>(paths[i]);
+        if (!read_file_buffer(paths[i], files[i].contents)) {
+            engine_log.warn("storage", "could not read ", paths[i], ".");
+        }
+        total_size += files[i].contents.size();
+    }
+    reading.end();
+
+    vector<Chunk> parsed;
+    if (total_size < PARALLEL_LOAD_THRESHOLD) {
+        for (size_t i = 0; i < files.size(); ++i) {
+            TraceSpan span("storage", "parse_chunk");
+            parsed.push_back(parse_chunk(files[i].contents, files[i]));
+            parsed.back().file = i;
+        }
+        return parsed;
+    }
+
+    ThreadPool& pool = shared_thread_pool();
+    vector<future<Chunk>> pending;
+    for (size_t i = 0; i < files.size(); ++i) {
+        const DataFile& file = files[i];
+        size_t max_chunks = max<size_t>(1, pool.size() * 4 * file.contents.size() / max<size_t>(1, total_size));
+        for (string_view chunk : split_into_chunks(file.contents, max_chunks)) {
+            pending.push_back(pool.submit([chunk, i, &file, parse_chunk]() {
+                TraceSpan span("storage", "parse_chunk");
+                Chunk result = parse_chunk(chunk, file);
+                result.file = i;
+                return result;
+            }));
+        }
+    }
+    for (auto& f : pending) {
+        parsed.push_back(f.get());
+    }
+    return parsed;
+}
+
+/**
+ * @brief Parses one resources.txt line into a new Resource. Returns nullptr for malformed lines.
+ * Only the header fields (id, type, name, location, availability) are parsed here. A lab or lecture
+ * hall keeps the file offset of its "Slots:...|Waitlist:..." text and parses it on first use.
+ */
+Resource* parse_resource_line(string_view line, int line_number, const DataFile& file, vector<ParseIssue>& issues) {
+    string_view parts[8];
+    size_t count = split_fields(line, '|', parts, 8);
+
+    if (count < 5) {
+        issues.push_back({line_number, "expected at least 5 fields"});
+        return nullptr;
+    }
+
+    int id;
+    if (!parse_int(parts[0], id)) {
+        issues.push_back({line_number, "invalid resource id '" + string(parts[0]) + "'"});
+        return nullptr;
+    }
+    string type(parts[1]);
+    string name(parts[2]);
+    Location location{string(parts[3])};
+    bool available = (parts[4] == "1");
+
+    if (type == "BUS" && count >= 7) {
+        Bus* bus = new Bus(id, name, type, location, available);
+        bus->setFromDate(string(parts[5]));
+        bus->setToDate(string(parts[6]));
+        int seats;
+        if (count >= 8 && parse_int(after_label(parts[7]), seats)) {
+            bus->setCapacity(seats);
+        }
+        return bus;
+    }
+
+    if ((type == "LAB" || type == "LECTUREHALL") && count >= 7) {
+        Lab* lab = (type == "LAB")
+                   ? new Lab(id, name, type, location, available)
+                   : new LectureHall(id, name, type, location, available);
+
+        // Slots and Waitlist stay on disk until the lab is first queried or booked
+        const char* slot_data = parts[5].data();
+        const char* line_end = line.data() + line.size();
+        lab->setSlotSource(file.path, slot_data - file.contents.data(), static_cast<size_t>(line_end - slot_data));
+        return lab;
+    }
+
+    issues.push_back({line_number, "unknown resource type '" + type + "' or missing fields"});
+    return nullptr;
+}
+
+/**
+ * @brief Resources parsed from one chunk of resources.txt, in file order.
+ */
+struct ResourceChunk {
+    size_t file = 0; // index into the list of files being loaded
+    vector<Resource*> resources;
+    vector<ParseIssue> issues;
+    int line_count = 0;
+};
+
+ResourceChunk parse_resource_chunk(string_view chunk, const DataFile& file) {
+    ResourceChunk result;
+    LineReader reader(chunk);
+    string_view line;
+    while (reader.next(line)) {
+        if (line.empty()) continue;
+        Resource* resource = parse_resource_line(line, reader.lineNumber(), file, result.issues);
+        if (resource) {
+            result.resources.push_back(resource);
+        }
+    }
+    result.line_count = count_lines(chunk);
+    return result;
+}
+
+/**
+ * @brief Loads resources and replaces the contents of the registry.
+ * Reads the segment files in resources.d/ when present, otherwise resources.txt. Large inputs are
+ * split at newline boundaries and parsed on the shared thread pool, then merged in file order.
+ * Only record headers are parsed up front; slot data is read per room on first use.
+ */
 void load_resources(map<int, Resource*>& resources_map) {
-    ifstream infile(RESOURCE_FILE);
-    if (!infile.is_open()) {
-        cout << "\nLoading: " << RESOURCE_FILE << " not found. Starting with default resources.\n";
+    MetricTimer timer(Metric::LoadResources);
+    bool segmented;
+    vector<string> paths = data_files(RESOURCE_SEGMENT_DIR, RESOURCE_FILE, segmented);
+    if (paths.empty()) {
+        engine_log.info("storage", "Loading: ", RESOURCE_FILE, " not found. Starting with default resources.");
         return;
     }
 
@@ -157,146 +515,202 @@ void load_resources(map<int, Resource*>& resources_map) {
     resources_map.clear();
     next_resource_id = 1;
 
-    string line;
+    vector<ResourceChunk> parsed = parse_data_files(paths, parse_resource_chunk);
+
+    // Merge in file order so later records with the same id still win
+    TraceSpan merging("storage", "merge_resources");
     int loaded_count = 0;
-    
-    while (getline(infile, line)) {
+    int line_offset = 0;
+    for (size_t c = 0; c < parsed.size(); ++c) {
+        ResourceChunk& chunk = parsed[c];
+        if (c > 0 && parsed[c - 1].file != chunk.file) {
+            line_offset = 0;
+        }
+        report_malformed(paths[chunk.file], chunk.issues, line_offset);
+        line_offset += chunk.line_count;
+
+        for (Resource* new_resource : chunk.resources) {
+            int id = new_resource->getId();
+            auto existing = resources_map.find(id);
+            if (existing != resources_map.end()) {
+                delete existing->second;
+            }
+            resources_map[id] = new_resource;
+            next_resource_id = max(next_resource_id, id + 1);
+            loaded_count++;
+        }
+    }
+    merging.end();
+
+    // Segments on disk now match memory. Records read from resources.txt stay dirty so the
+    // first save writes them out in the segmented layout.
+    if (segmented) {
+        for (auto& pair : resources_map) { pair.second->clearDirty(); }
+        resource_changes().clear();
+    }
+
+    engine_log.info("storage", "Loaded ", loaded_count, " resources from ", segmented ? RESOURCE_SEGMENT_DIR + "/" : RESOURCE_FILE, ".");
+}
+
+/**
+ * @brief One users.txt record. Bookings are kept as raw (resource id, slot id) pairs until linking.
+ */
+struct UserRecord {
+    int id;
+    string name;
+    string passwordHash;
+    string type;
+    vector<pair<int, int>> bookings;
+};
+
+struct UserChunk {
+    size_t file = 0;
+    vector<UserRecord> users;
+    vector<ParseIssue> issues;
+    int line_count = 0;
+};
+
+UserChunk parse_user_chunk(string_view chunk, const DataFile&) {
+    UserChunk result;
+    LineReader reader(chunk);
+    string_view line;
+
+    while (reader.next(line)) {
         if (line.empty()) continue;
 
-        stringstream ss(line);
-        string segment;
-        vector<string> parts;
-        
-        while (getline(ss, segment, '|')) {
-            parts.push_back(segment);
+        string_view parts[5];
+        if (split_fields(line, '|', parts, 5) != 5) {
+            result.issues.push_back({reader.lineNumber(), "expected 5 fields"});
+            continue;
         }
 
-        if (parts.size() < 5) continue;
-
-        int id = stoi(parts[0]);
-        string type = parts[1];
-        string name = parts[2];
-        Location location(parts[3]);
-        bool available = (parts[4] == "1");
-
-        Resource* new_resource = nullptr;
-
-        if (type == "BUS" && parts.size() >= 7) {
-            Bus* bus = new Bus(id, name, type, location, available);
-            bus->setFromDate(parts[5]);
-            bus->setToDate(parts[6]);
-            new_resource = bus;
-        } else if ((type == "LAB" || type == "LECTUREHALL") && parts.size() >= 7) {
-            Lab* lab = (type == "LAB") 
-                       ? new Lab(id, name, type, location, available) // false = do not add default slots
-                       : new LectureHall(id, name, type, location, available);
-            
-            // 1. Load Slots
-            string slots_data = parts[5].substr(parts[5].find(":") + 1);
-            stringstream ss_slots(slots_data);
-            string slot_segment;
-            
-            while (getline(ss_slots, slot_segment, ';')) {
-                if (slot_segment.empty()) continue;
-                stringstream ss_slot(slot_segment);
-                string s_part;
-                vector<string> s_parts;
-                while (getline(ss_slot, s_part, ',')) { s_parts.push_back(s_part); }
-
-                if (s_parts.size() == 5) {
-                    Slot s(stoi(s_parts[0]), s_parts[1], s_parts[2], s_parts[3]);
-                    s.isBooked = (s_parts[4] == "1");
-                    lab->addSlot(s);
-                }
-            }
-            
-            // 2. Load Waitlist
-            string waitlist_data = parts[6].substr(parts[6].find(":") + 1);
-            stringstream ss_waitlist(waitlist_data);
-            string user_segment;
-            
-            while (getline(ss_waitlist, user_segment, ',')) {
-                if (!user_segment.empty()) {
-                    lab->loadWaitlist(stoi(user_segment));
-                }
+        UserRecord record;
+        if (!parse_int(parts[0], record.id)) {
+            result.issues.push_back({reader.lineNumber(), "invalid user id '" + string(parts[0]) + "'"});
+            continue;
+        }
+        record.name = string(parts[1]);
+        record.passwordHash = string(parts[2]);
+        record.type = string(parts[3]);
+
+        // Bookings: RId,SId;RId,SId;...
+        FieldSplitter booking_splitter(after_label(parts[4]), ';');
+        string_view booking_segment;
+        while (booking_splitter.next(booking_segment)) {
+            if (booking_segment.empty()) continue;
+
+            string_view b_parts[2];
+            int rid, sid;
+            if (split_fields(booking_segment, ',', b_parts, 2) < 2
+                || !parse_int(b_parts[0], rid) || !parse_int(b_parts[1], sid)) {
+                result.issues.push_back({reader.lineNumber(), "invalid booking '" + string(booking_segment) + "'"});
+                continue;
             }
-            new_resource = lab;
+            record.bookings.push_back({rid, sid});
         }
+        result.users.push_back(move(record));
+    }
+    result.line_count = count_lines(chunk);
+    return result;
+}
 
-        if (new_resource) {
-            resources_map[id] = new_resource;
-            next_resource_id = max(next_resource_id, id + 1);
-            loaded_count++;
+/**
+ * @brief Links a user's parsed bookings to the loaded resources.
+ */
+void link_user_bookings(User* user, const UserRecord& record) {
+    for (const auto& booking : record.bookings) {
+        if (resources_table.count(booking.first)) {
+            Resource* resource = resources_table.at(booking.first);
+            user->loadBooking(resource, booking.second);
+            // Bus bookings carry the travel day; the seat counters are rebuilt from them
+            if (Bus* bus = dynamic_cast<Bus*>(resource)) {
+                bus->restoreSeat(booking.second);
+            }
         }
     }
-    
-    infile.close();
-    cout << "\nLoaded " << loaded_count << " resources from " << RESOURCE_FILE << ".\n";
 }
 
+/**
+ * @brief Loads users (users.d/ segments, or users.txt) and rebuilds the user table.
+ * Chunks are parsed in parallel, users are inserted in file order, and booking-to-resource linking
+ * runs as a final parallel pass over the users (each user is touched by exactly one task).
+ */
 void load_users(HashTable& user_table) {
-    ifstream infile(USER_FILE);
-    if (!infile.is_open()) {
-        cout << "\nLoading: " << USER_FILE << " not found. Starting with default users.\n";
+    MetricTimer timer(Metric::LoadUsers);
+    bool segmented;
+    vector<string> paths = data_files(USER_SEGMENT_DIR, USER_FILE, segmented);
+    if (paths.empty()) {
+        engine_log.info("storage", "Loading: ", USER_FILE, " not found. Starting with default users.");
         return;
     }
 
-    // Clear existing users
-    user_table = HashTable(user_table.getSize());
+    ThreadPool& pool = shared_thread_pool();
+    vector<UserChunk> parsed = parse_data_files(paths, parse_user_chunk);
+
+    // Clear existing users, with a bucket per record so chains stay short while inserting
+    size_t record_count = 0;
+    for (const UserChunk& chunk : parsed) {
+        record_count += chunk.users.size();
+    }
+    user_table = HashTable(max(user_table.getSize(), static_cast<int>(record_count)));
     next_user_id = 1;
 
-    string line;
+    // Re-insert users into the hash table in file order
+    TraceSpan inserting("storage", "insert_users");
     int loaded_count = 0;
-    
-    while (getline(infile, line)) {
-        if (line.empty()) continue;
-
-        stringstream ss(line);
-        string segment;
-        vector<string> parts;
-        
-        while (getline(ss, segment, '|')) {
-            parts.push_back(segment);
+    int line_offset = 0;
+    vector<pair<User*, const UserRecord*>> to_link;
+    vector<pair<User*, const UserRecord*>> duplicates;
+    vector<pair<User*, int>> renumbered; // users given a free ID, and the taken ID from the file
+    for (size_t c = 0; c < parsed.size(); ++c) {
+        const UserChunk& chunk = parsed[c];
+        if (c > 0 && parsed[c - 1].file != chunk.file) {
+            line_offset = 0;
         }
+        report_malformed(paths[chunk.file], chunk.issues, line_offset);
+        line_offset += chunk.line_count;
+
+        for (const UserRecord& record : chunk.users) {
+            int users_before = user_table.getUserCount();
+            User* loaded_user = user_table.insert(record.id, record.name, record.passwordHash, record.type);
+            bool existed = user_table.getUserCount() == users_before;
+            next_user_id = max(next_user_id, loaded_user->getId() + 1);
+            if (loaded_user->getId() != record.id && !existed) {
+                renumbered.push_back({loaded_user, record.id});
+            }
 
-        if (parts.size() == 5) {
-            int id = stoi(parts[0]);
-            string name = parts[1];
-            string passwordHash = parts[2];
-            string type = parts[3];
-            string bookings_data = parts[4].substr(parts[4].find(":") + 1);
-
-            // Re-insert user into the hash table
-            user_table.insert(id, name, passwordHash, type);
-            User* loaded_user = user_table.get(name);
-            next_user_id = max(next_user_id, id + 1);
-
-            // Load Bookings
-            if (loaded_user) {
-                stringstream ss_bookings(bookings_data);
-                string booking_segment;
-                while (getline(ss_bookings, booking_segment, ';')) {
-                    if (booking_segment.empty()) continue;
-                    
-                    stringstream ss_booking(booking_segment);
-                    string rid_str, sid_str;
-                    
-                    if (getline(ss_booking, rid_str, ',') && getline(ss_booking, sid_str, ',')) {
-                        int rid = stoi(rid_str);
-                        int sid = stoi(sid_str);
-                        
-                        if (resources_table.count(rid)) {
-                            loaded_user->loadBooking(rid, sid);
-                        }
-                    }
-                }
+            if (!record.bookings.empty()) {
+                // A repeated name appends to an already-linked user, so keep those off the parallel pass
+                (existed ? duplicates : to_link).push_back({loaded_user, &record});
             }
             loaded_count++;
         }
     }
-    
-    infile.close();
-    cout << "\nLoaded " << loaded_count << " users from " << USER_FILE << ".\n";
+
+    inserting.end();
+
+    // Load Bookings: resources_table is only read here, and each user belongs to a single task
+    parallel_for(pool, to_link.size(), [&to_link](size_t begin, size_t end) {
+        TraceSpan span("storage", "link_bookings");
+        for (size_t i = begin; i < end; ++i) {
+            link_user_bookings(to_link[i].first, *to_link[i].second);
+        }
+    }, 1024);
+    for (const auto& entry : duplicates) {
+        link_user_bookings(entry.first, *entry.second);
+    }
+
+    if (segmented) {
+        user_table.clearDirtyFlags();
+        user_changes().clear();
+    }
+    // Both segments are rewritten at the next save, so the file stops repeating the ID
+    for (const auto& entry : renumbered) {
+        entry.first->markDirty();
+        user_changes().record(entry.second);
+    }
+
+    engine_log.info("storage", "Loaded ", loaded_count, " users from ", segmented ? USER_SEGMENT_DIR + "/" : USER_FILE, ".");
 }
 
 #endif // TEXTFILES_H
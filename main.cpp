@@ -6,6 +6,7 @@
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <csignal>
 
 #include "Headers/Hashtable.h"
 #include "Headers/User.h"
@@ -17,6 +18,15 @@
 #include "Headers/Slot.h"
 #include "Headers/Location.h"
 #include "Headers/Map.h"
+#include "Headers/CampusRouter.h"
+#include "Headers/Nearby.h"
+#include "Headers/Timetable.h"
+#include "Headers/Engine.h"
+#include "Headers/Batch.h"
+#include "Headers/Server.h"
+#include "Headers/Session.h"
+#include "Headers/Metrics.h"
+#include "Headers/Trace.h"
 
 using namespace std;
 
@@ -25,6 +35,13 @@ int next_user_id = 1;
 int next_resource_id = 1;
 map<int, Resource*> resources_table;
 NULMapGraph campus_map;
+CampusRouter campus_router(campus_map);
+BusTimetable bus_timetable;
+const string ROUTE_TABLE_FILE = "campus_routes.bin";
+const string HIERARCHY_FILE = "campus_hierarchy.bin";
+const string CAMPUS_MAP_FILE = "campus_map.txt";
+const string CAMPUS_GRAPH_FILE = "campus_map.bin";
+const string TIMETABLE_FILE = "timetable.txt";
 
 // Function Prototypes
 static void printMenu();
@@ -32,9 +49,122 @@ void initialize_resources(map<int, Resource*>& resources_map);
 void print_all_resources(const map<int, Resource*>& resources_map);
 void cleanup_resources(map<int, Resource*>& resources_map);
 void initialize_map(NULMapGraph& graph);
+void initialize_rooms(CampusRouter& router);
+int run_batch_mode(HashTable& user_db, const string& input_path, const string& output_path, bool save, streambuf* console);
+int run_server_mode(HashTable& user_db, const string& socket_path, size_t worker_count, bool dialogue, bool save);
+bool write_metrics_file(const string& path);
+bool write_trace_file(const string& path);
+
+int main(int argc, char* argv[]) {
+    // Command line: --batch <requests.jsonl> [--out <results.jsonl>] [--save]
+    //               --precompute-routes [--route-table-limit <nodes>]
+    //               --contract (contraction hierarchy for maps above the route table limit)
+    //               --map <campus_map.txt>
+    //               --serve <socket> [--workers <n>] [--save] (Linux only)
+    //               --serve <socket> --dialogue (the menu as a text dialogue; C++20 builds)
+    //               --log-level debug|info|warn|error|off [--log-file <path>]
+    //               --metrics-file <metrics.json|metrics.prom> (written when batch/server mode ends)
+    //               --trace <trace.json> (Chrome trace of startup and requests, written on exit)
+    string batch_input, batch_output, serve_socket;
+    size_t serve_workers = 0;
+    bool serve_dialogue = false;
+    bool batch_save = false;
+    bool precompute_routes = false;
+    size_t route_table_limit = DEFAULT_ROUTE_TABLE_MAX_NODES;
+    bool contract_map = false;
+    string map_file = CAMPUS_MAP_FILE;
+    string log_file;
+    string metrics_file;
+    string trace_file;
+    LogLevel log_level = LogLevel::Info;
+    bool log_level_given = false;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--batch" && i + 1 < argc) {
+            batch_input = argv[++i];
+        } else if (arg == "--out" && i + 1 < argc) {
+            batch_output = argv[++i];
+        } else if (arg == "--save") {
+            batch_save = true;
+        } else if (arg == "--precompute-routes") {
+            precompute_routes = true;
+        } else if (arg == "--route-table-limit" && i + 1 < argc) {
+            route_table_limit = static_cast<size_t>(atol(argv[++i]));
+        } else if (arg == "--contract") {
+            contract_map = true;
+        } else if (arg == "--map" && i + 1 < argc) {
+            map_file = argv[++i];
+        } else if (arg == "--serve" && i + 1 < argc) {
+            serve_socket = argv[++i];
+        } else if (arg == "--log-level" && i + 1 < argc && parse_log_level(argv[i + 1], log_level)) {
+            log_level_given = true;
+            ++i;
+        } else if (arg == "--log-file" && i + 1 < argc) {
+            log_file = argv[++i];
+        } else if (arg == "--metrics-file" && i + 1 < argc) {
+            metrics_file = argv[++i];
+        } else if (arg == "--trace" && i + 1 < argc) {
+            trace_file = argv[++i];
+        } else if (arg == "--dialogue") {
+            serve_dialogue = true;
+        } else if (arg == "--workers" && i + 1 < argc) {
+            serve_workers = static_cast<size_t>(atol(argv[++i]));
+        } else {
+            cerr << "Unknown argument: " << arg << "\n";
+            cerr << "Usage: " << argv[0] << " [--batch <requests.jsonl> [--out <results.jsonl>] [--save]]"
+                 << " [--precompute-routes [--route-table-limit <nodes>]] [--contract] [--map <file>]"
+                 << " [--serve <socket> [--dialogue] [--workers <n>] [--save]]"
+                 << " [--log-level debug|info|warn|error|off] [--log-file <path>] [--metrics-file <path>]"
+                 << " [--trace <path>]\n";
+            return 1;
+        }
+    }
 
-int main() {
-    initialize_map(campus_map);
+    if (!trace_file.empty()) {
+        tracer.enable();
+        tracer.nameThread("main");
+    }
+    TraceSpan startup("startup", "startup");
+
+    // Batch and server modes print nothing but results, so silence the engine's console output.
+    // Their engine events go to stderr from warnings up; the menu shows them as they happen.
+    streambuf* console = cout.rdbuf();
+    bool unattended = !batch_input.empty() || !serve_socket.empty();
+    if (unattended) {
+        cout.rdbuf(nullptr);
+        engine_log.toConsole(cerr);
+        engine_log.setLevel(log_level_given ? log_level : LogLevel::Warn);
+    } else {
+        engine_log.setLevel(log_level);
+        engine_log.setImmediate(log_file.empty());
+    }
+    if (!log_file.empty() && !engine_log.toFile(log_file)) {
+        cerr << "ERROR: Could not open " << log_file << " for logging.\n";
+        return 1;
+    }
+
+    // The compiled map is cached next to the map file and mapped back in on later runs
+    string compiled_map_file = map_file == CAMPUS_MAP_FILE ? CAMPUS_GRAPH_FILE : map_file + ".bin";
+    if (!campus_map.load_map(map_file, compiled_map_file)) {
+        cerr << "\nWarning: could not read " << map_file << "; using the built-in campus map.\n";
+        initialize_map(campus_map);
+    }
+    initialize_rooms(campus_router);
+    campus_map.freeze();
+    bool table_ready = false;
+    if (precompute_routes) {
+        table_ready = campus_map.precompute_routes(route_table_limit, ROUTE_TABLE_FILE);
+        if (table_ready) {
+            cout << "\nRoute table ready: " << campus_map.compiled_graph().nodeCount() << " locations, "
+                 << campus_map.route_table_bytes() << " bytes.\n";
+        } else {
+            cout << "\nMap has more than " << route_table_limit << " locations; routes will be searched on demand.\n";
+        }
+    }
+    if (contract_map && !table_ready && campus_map.prepare_hierarchy(HIERARCHY_FILE)) {
+        cout << "\nContraction hierarchy ready: " << campus_map.contraction_hierarchy()->shortcutCount()
+             << " shortcuts, " << campus_map.contraction_hierarchy()->memoryBytes() << " bytes.\n";
+    }
     
     HashTable user_db(10);
     
@@ -43,6 +173,26 @@ int main() {
     user_db.insert(next_user_id++, "Thapelo", "adminpass", "Admin");
     load_resources(resources_table);
     load_users(user_db);
+    // Bus services run on the buses that were just loaded
+    if (!load_timetable(bus_timetable, TIMETABLE_FILE, resources_table, campus_map)) {
+        engine_log.info("timetable", TIMETABLE_FILE, " not found; journeys are planned on foot only.");
+    }
+    startup.end();
+
+    if (!batch_input.empty()) {
+        int status = run_batch_mode(user_db, batch_input, batch_output, batch_save, console);
+        cout.rdbuf(console);
+        if (!metrics_file.empty() && !write_metrics_file(metrics_file)) status = 1;
+        if (!trace_file.empty() && !write_trace_file(trace_file)) status = 1;
+        return status;
+    }
+    if (!serve_socket.empty()) {
+        int status = run_server_mode(user_db, serve_socket, serve_workers, serve_dialogue, batch_save);
+        cout.rdbuf(console);
+        if (!metrics_file.empty() && !write_metrics_file(metrics_file)) status = 1;
+        if (!trace_file.empty() && !write_trace_file(trace_file)) status = 1;
+        return status;
+    }
 
     int choice;
     while (true) {
@@ -82,7 +232,10 @@ int main() {
                 }
 
                 cout << "Enter password: "; getline(cin, password);
-                user_db.insert(next_user_id++, name, password, "Regular");
+                if (signup_user(user_db, name, password) != EngineStatus::Ok) {
+                    cout << "\nUsername already exists. Please choose another.\n";
+                    break;
+                }
                 cout << "Account created for " << name << ". Please log in.\n";
                 break;
             }
@@ -99,11 +252,24 @@ int main() {
             }
             
             case 5: { // Display All Users
-                if (!currentUser || currentUser->getType() != "Admin") { cout << "Access denied. Admin privileges required.\n"; break; }
+                if (!currentUser || currentUser->getUserType() != UserType::Admin) { cout << "Access denied. Admin privileges required.\n"; break; }
                 user_db.display();
                 break;
             }
 
+            case 11: { // Operation Metrics
+                if (!currentUser || currentUser->getUserType() != UserType::Admin) { cout << "Access denied. Admin privileges required.\n"; break; }
+                operation_metrics.printTable(cout);
+                cout << "\nExport: j) JSON to metrics.json, p) Prometheus text to metrics.prom, Enter) back: ";
+                string format;
+                getline(cin, format);
+                if (format == "j" || format == "p") {
+                    string path = format == "j" ? "metrics.json" : "metrics.prom";
+                    if (write_metrics_file(path)) cout << "Metrics written to " << path << ".\n";
+                }
+                break;
+            }
+
             case 6: { // Add booking
                 if (!currentUser) { cout << "\nPlease login first.\n"; break; }
                 
@@ -133,8 +299,7 @@ int main() {
                     }
                     cin.ignore(numeric_limits<streamsize>::max(), '\n');
 
-                    if (resource->bookSlot(sid)) {
-                        currentUser->addBooking(resource,sid);
+                    if (book_resource(resources_table, currentUser, rid, sid) == EngineStatus::Ok) {
                         cout << "\nSuccessfully booked slot " << sid << " for resource ID " << rid << ".\n";
                     } else {
                         // Slot already booked or not found.,Prompt waitlist.
@@ -144,12 +309,28 @@ int main() {
                         cin >> join;
                         cin.ignore(numeric_limits<streamsize>::max(), '\n');
                         if (tolower(join) == 'y') {
-                            currentUser->addToResourceWaitlist(resource);
+                            join_waitlist(resources_table, currentUser, rid);
                         }
                     }
-                } else if (resourceB->getType() == "BUS") {
-                    currentUser->addBooking(resourceB);
-                    cout << "\nSuccessfully booked Bus ID " << rid << ".\n";
+                } else if (Bus* bus = dynamic_cast<Bus*>(resourceB)) {
+                    string date;
+                    int day;
+                    cout << "\nEnter travel date (DD-MM-YYYY): "; getline(cin, date);
+                    if (!parse_date(date, day)) {
+                        cout << "\nInvalid date.\n"; break;
+                    }
+                    EngineStatus status = book_resource(resources_table, currentUser, rid, day);
+                    if (status == EngineStatus::Ok) {
+                        cout << "\nSuccessfully booked a seat on Bus ID " << rid << " for " << date
+                             << " (" << bus->seatsLeft(day) << " seats left).\n";
+                    } else if (status == EngineStatus::InvalidDate) {
+                        cout << "\nThe bus only runs from " << bus->getFromDate() << " to " << bus->getToDate() << ".\n";
+                    } else {
+                        vector<int> free_days = bus->daysWithSeats(day + 1, day + 14);
+                        cout << "\nBus ID " << rid << " is fully booked on " << date << ".";
+                        if (!free_days.empty()) cout << " Next date with seats: " << format_date(free_days.front()) << ".";
+                        cout << "\n";
+                    }
                 } else {
                     cout << "\nBooking not supported for this resource type.\n";
                 }
@@ -173,8 +354,7 @@ int main() {
 
                 Resource* resourceB = resources_table.at(rid);
 
-                if (resourceB->getType() == "LAB" || resourceB->getType() == "LECTUREHALL") {
-                    Lab* resource = dynamic_cast<Lab*>(resourceB);
+                if (is_slotted(resourceB)) {
                     int sid;
                     cout << "\nResource is slotted. Enter Slot ID to cancel: ";
                     if (!(cin >> sid)) {
@@ -183,13 +363,19 @@ int main() {
                     cin.ignore(numeric_limits<streamsize>::max(), '\n');
 
                     // Cancel slot and process waitlist if successful
-                    if (resource->cancelSlotBooking(sid)) {
-                        currentUser->removeBooking(rid);
-                    } else {
+                    if (cancel_booking(resources_table, currentUser, rid, sid) != EngineStatus::Ok) {
                         cout << "\nSlot not found or was not booked.\n";
                     }
+                } else if (resourceB->getType() == "BUS") {
+                    string date;
+                    int day = -1;
+                    cout << "\nTravel date to cancel (DD-MM-YYYY, blank for all): "; getline(cin, date);
+                    if (!date.empty() && !parse_date(date, day)) {
+                        cout << "\nInvalid date.\n"; break;
+                    }
+                    cancel_booking(resources_table, currentUser, rid, day);
                 } else {
-                    currentUser->removeBooking(rid);
+                    cancel_booking(resources_table, currentUser, rid);
                 }
                 break;
             }
@@ -197,12 +383,17 @@ int main() {
             case 8: { // Map Navigation (Shortest Path)
                 string start_node, end_node;
                 vector<string> nodes = campus_map.get_nodes();
+                vector<string> rooms = campus_router.rooms();
 
                 cout << "\n--- Map Navigation ---\n";
                 cout << "Available Locations:\n";
                 for (size_t i = 0; i < nodes.size(); ++i) {
                     cout << i + 1 << ") " << nodes[i] << "\n";
                 }
+                cout << "Rooms:\n";
+                for (const string& room : rooms) {
+                    cout << "   " << room << " (" << campus_router.buildingOf(room) << ")\n";
+                }
 
                 auto get_location = [&](const string& prompt) -> string {
                     string input;
@@ -210,9 +401,8 @@ int main() {
                         cout << prompt;
                         getline(cin, input);
                         
-                        // Simple check to see if the location is valid
-                        auto it = find(nodes.begin(), nodes.end(), input);
-                        if (it != nodes.end()) {
+                        // Simple check to see if the location is valid (building or room)
+                        if (campus_router.knows(input)) {
                             return input;
                         }
                         cout << "Invalid location. Please choose from the list.\n";
@@ -222,12 +412,64 @@ int main() {
                 start_node = get_location("Enter starting location: ");
                 end_node = get_location("Enter destination location: ");
                 
-                // 1. Run Dijkstra's algorithm
-                auto result = campus_map.dijkstra_shortest_path(start_node, end_node);
-                vector<string> path = result.first;
-                double distance = result.second;
+                // 1. Building leg on the campus map plus room legs inside the buildings
+                Route route = campus_router.route(start_node, end_node);
 
-                campus_map.print_shortest_path(start_node, end_node, path, distance);
+                campus_map.print_shortest_path(start_node, end_node, route);
+                break;
+            }
+
+            case 9: { // Nearest free lab / lecture hall
+                string from;
+                cout << "\nEnter your current location (building or room): ";
+                getline(cin, from);
+                if (!campus_router.knows(from)) {
+                    cout << "\nUnknown location.\n"; break;
+                }
+                int sid;
+                size_t k = 3;
+                cout << "Enter slot ID: ";
+                if (!(cin >> sid)) {
+                    cout << "\nInvalid input.\n"; cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n'); break;
+                }
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                string type;
+                cout << "Type (LAB, LECTUREHALL or blank for any): ";
+                getline(cin, type);
+
+                ResourceLocator locator(resources_table);
+                vector<NearbyResource> nearby = nearest_free_resources(campus_map, locator, campus_router.buildingOf(from), sid, k, type);
+                if (nearby.empty()) {
+                    cout << "\nNo free resource found for slot " << sid << ".\n"; break;
+                }
+                cout << "\nNearest free resources for slot " << sid << ":\n";
+                for (const NearbyResource& entry : nearby) {
+                    cout << "   ID " << entry.resource->getId() << ": " << entry.resource->getName()
+                         << " (" << entry.resource->getLocation().getName() << ", "
+                         << fixed << setprecision(1) << entry.minutes << " min walk)\n";
+                }
+                break;
+            }
+
+            case 10: { // Journey planner (walk + bus)
+                string from, to, depart;
+                cout << "\nEnter starting building: "; getline(cin, from);
+                cout << "Enter destination building: "; getline(cin, to);
+                if (!campus_map.has_node(from) || !campus_map.has_node(to)) {
+                    cout << "\nUnknown location.\n"; break;
+                }
+                string date;
+                int day;
+                cout << "Travel date (DD-MM-YYYY): "; getline(cin, date);
+                if (!parse_date(date, day)) {
+                    cout << "\nInvalid date.\n"; break;
+                }
+                double departure;
+                cout << "Departure time (HH:MM): "; getline(cin, depart);
+                if (!parse_clock_time(depart, departure)) {
+                    cout << "\nInvalid time.\n"; break;
+                }
+                print_journey(from, to, bus_timetable.plan(campus_map, from, to, departure, day));
                 break;
             }
 
@@ -235,6 +477,7 @@ int main() {
                 save_resources(resources_table);
                 save_users(user_db);
                 cleanup_resources(resources_table);
+                if (!trace_file.empty()) write_trace_file(trace_file);
                 cout << "Exiting application. Goodbye!\n";
                 return 0;
             }
@@ -266,12 +509,146 @@ static void printMenu() {
     cout << "6)  Add Booking (Includes Waitlist)\n";
     cout << "7)  Remove Booking (Processes Waitlist)\n";
     cout << "8)  Map Navigation (Shortest Path) <-\n";
+    cout << "9)  Find Nearest Free Lab/Hall\n";
+    cout << "10) Plan Journey (Walk + Bus)\n";
+    cout << "11) Operation Metrics (Admin Only)\n";
     cout << "0)  Quit\n";
     cout << "------------------------------------------------\n";
     cout << "Choose an option : ";
 }
 
+/**
+ * @brief Writes a snapshot of the operation metrics: Prometheus text for a ".prom" path,
+ * JSON otherwise.
+ */
+bool write_metrics_file(const string& path) {
+    ofstream out(path);
+    if (!out.is_open()) {
+        cerr << "ERROR: Could not open " << path << " for writing.\n";
+        return false;
+    }
+    bool prometheus = path.size() >= 5 && path.compare(path.size() - 5, 5, ".prom") == 0;
+    if (prometheus) {
+        operation_metrics.writePrometheus(out);
+    } else {
+        operation_metrics.writeJson(out);
+    }
+    return static_cast<bool>(out);
+}
+
+/**
+ * @brief Writes the spans recorded since startup as a Chrome trace (open it in ui.perfetto.dev
+ * or chrome://tracing).
+ */
+bool write_trace_file(const string& path) {
+    if (!tracer.write(path)) {
+        cerr << "ERROR: Could not write trace " << path << ".\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Runs a JSON-lines request file through the engine and writes one JSON result per request
+ * (to output_path, or the console when empty). Changes are only saved when `save` is set.
+ */
+int run_batch_mode(HashTable& user_db, const string& input_path, const string& output_path, bool save, streambuf* console) {
+    ifstream input(input_path);
+    if (!input.is_open()) {
+        cerr << "ERROR: Could not open " << input_path << " for reading.\n";
+        return 1;
+    }
+
+    ofstream output_file;
+    if (!output_path.empty()) {
+        output_file.open(output_path);
+        if (!output_file.is_open()) {
+            cerr << "ERROR: Could not open " << output_path << " for writing.\n";
+            return 1;
+        }
+    }
+    // cout is silenced in batch mode, so console results go through the saved console buffer
+    ostream console_stream(console);
+    ostream& output = output_path.empty() ? console_stream : output_file;
+
+    BatchProcessor processor(user_db, resources_table, campus_router, &bus_timetable);
+    size_t processed = processor.run(input, output);
+    cerr << "Processed " << processed << " requests from " << input_path << ".\n";
+    const RouteCache& cache = campus_map.route_cache_stats();
+    cerr << "Route cache: " << cache.hits() << " hits, " << cache.misses() << " misses.\n";
+
+    if (save) {
+        save_resources(resources_table);
+        save_users(user_db);
+    }
+    cleanup_resources(resources_table);
+    return 0;
+}
+
+#ifdef __linux__
+static RequestServer* active_server = nullptr;
+#if __cplusplus >= 202002L
+static SessionServer* active_sessions = nullptr;
+#endif
+
+static void stop_server(int) {
+    if (active_server) active_server->stop();
+#if __cplusplus >= 202002L
+    if (active_sessions) active_sessions->stop();
+#endif
+}
+#endif
+
+int run_server_mode(HashTable& user_db, const string& socket_path, size_t worker_count, bool dialogue, bool save) {
+#ifdef __linux__
+    signal(SIGINT, stop_server);
+    signal(SIGTERM, stop_server);
+    if (dialogue) {
+#if __cplusplus >= 202002L
+        SessionServer server(user_db, resources_table, worker_count);
+        if (!server.listen(socket_path)) {
+            cerr << "ERROR: Could not listen on " << socket_path << ".\n";
+            return 1;
+        }
+        cerr << "Serving menu sessions on " << socket_path << " with " << server.loopCount()
+             << " event loops (Ctrl+C to stop).\n";
+        active_sessions = &server;
+        server.run();
+        active_sessions = nullptr;
+#else
+        cerr << "ERROR: --dialogue needs a C++20 build (g++ -std=c++20).\n";
+        return 1;
+#endif
+    } else {
+        BatchProcessor processor(user_db, resources_table, campus_router, &bus_timetable);
+        RequestServer server(processor, worker_count);
+        if (!server.listen(socket_path)) {
+            cerr << "ERROR: Could not listen on " << socket_path << ".\n";
+            return 1;
+        }
+        cerr << "Serving requests on " << socket_path << " with " << server.workerCount()
+             << " workers (Ctrl+C to stop).\n";
+        active_server = &server;
+        server.run();
+        active_server = nullptr;
+    }
+    cerr << "Server stopped.\n";
+
+    if (save) {
+        save_resources(resources_table);
+        save_users(user_db);
+    }
+    cleanup_resources(resources_table);
+    return 0;
+#else
+    (void)user_db; (void)socket_path; (void)worker_count; (void)dialogue; (void)save;
+    cerr << "ERROR: Server mode is only available on Linux.\n";
+    return 1;
+#endif
+}
+
 void initialize_resources(map<int, Resource*>& resources_map) {
+    TraceSpan span("startup", "initialize_resources");
     // 1. LAB Resources 
     resources_map[next_resource_id] = new Lab(next_resource_id, "ICT Lab", "LAB", Location("ICT Building"), true);
     next_resource_id++;
@@ -315,7 +692,8 @@ void print_all_resources(const map<int, Resource*>& resources_map) {
             }
         } else if (r->getType() == "BUS") {
             Bus* bus_ptr = dynamic_cast<Bus*>(r);
-            cout << " - Route Active: " << bus_ptr->getFromDate() << " to " << bus_ptr->getToDate();
+            cout << " - Route Active: " << bus_ptr->getFromDate() << " to " << bus_ptr->getToDate()
+                 << ", " << bus_ptr->getCapacity() << " seats per day";
         }
         cout << "\n";
     }
@@ -330,6 +708,7 @@ void cleanup_resources(map<int, Resource*>& resources_map) {
 }
 
 void initialize_map(NULMapGraph& graph) {
+    TraceSpan span("startup", "initialize_map");
     graph.add_path("Main Library", "Admin Block", 2.0);
     graph.add_path("Main Library", "Old Science Building", 2.0);
     graph.add_path("ISAS Building", "DTF", 3.0);
@@ -349,3 +728,42 @@ void initialize_map(NULMapGraph& graph) {
     graph.add_path("Moshoeshoe Building", "Main Library", 1.5);
 }
 
+
+/**
+ * @brief Room graphs for the buildings that have them. Ids are local to each building;
+ * walking times are in minutes like the campus map.
+ */
+void initialize_rooms(CampusRouter& router) {
+    TraceSpan span("startup", "initialize_rooms");
+    // New Science Building: ground floor entrance and stairs, three floors of SCN rooms
+    router.addRoom("New Science Building", 1, "SCN Entrance", true);
+    router.addRoom("New Science Building", 2, "SCN Stairs G");
+    router.addRoom("New Science Building", 3, "SCN Stairs 2");
+    router.addRoom("New Science Building", 4, "SCN Stairs 3");
+    router.addRoom("New Science Building", 10, "SCN101");
+    router.addRoom("New Science Building", 20, "SCN201");
+    router.addRoom("New Science Building", 21, "SCN202");
+    router.addRoom("New Science Building", 30, "SCN301");
+    router.addRoom("New Science Building", 31, "SCN302");
+    router.addRoom("New Science Building", 32, "SCN303");
+    router.addCorridor("New Science Building", 1, 2, 0.5);
+    router.addCorridor("New Science Building", 1, 10, 0.5);
+    router.addCorridor("New Science Building", 2, 3, 1.0);
+    router.addCorridor("New Science Building", 3, 4, 1.0);
+    router.addCorridor("New Science Building", 3, 20, 0.5);
+    router.addCorridor("New Science Building", 20, 21, 0.5);
+    router.addCorridor("New Science Building", 4, 30, 0.5);
+    router.addCorridor("New Science Building", 30, 31, 0.5);
+    router.addCorridor("New Science Building", 31, 32, 0.5);
+
+    // ICT Lab: two entrances on either side of the lab corridor
+    router.addRoom("ICT Lab", 1, "ICT Front Entrance", true);
+    router.addRoom("ICT Lab", 2, "ICT Back Entrance", true);
+    router.addRoom("ICT Lab", 10, "ICT Lab 1");
+    router.addRoom("ICT Lab", 11, "ICT Lab 2");
+    router.addRoom("ICT Lab", 12, "ICT Lab 3");
+    router.addCorridor("ICT Lab", 1, 10, 0.5);
+    router.addCorridor("ICT Lab", 10, 11, 0.5);
+    router.addCorridor("ICT Lab", 11, 12, 0.5);
+    router.addCorridor("ICT Lab", 12, 2, 0.5);
+}